@@ -1,12 +1,344 @@
-u32 crc32(Slice<u8> buf){
+static inline
+u32 crc32_load_be32(u8 const* p){
+	return (u32(p[0]) << 24) | (u32(p[1]) << 16) | (u32(p[2]) << 8) | u32(p[3]);
+}
+
+static inline
+u32 crc32_bytewise_ex(u32 remainder, u8 const* data, usize len){
 	constexpr u32 bit_width = sizeof(u32) * 8;
-    u8 data = 0;
-    u32 remainder = 0;
 
-    for (usize i = 0; i < buf.len; ++i) {
-        data = buf[i] ^ (remainder >> (bit_width - 8));
-        remainder = crc32_lut[data] ^ (remainder << 8);
-    }
+	for (usize i = 0; i < len; ++i) {
+		u8 index = data[i] ^ (remainder >> (bit_width - 8));
+		remainder = crc32_lut[index] ^ (remainder << 8);
+	}
+
+	return remainder;
+}
+
+u32 crc32_bytewise(Slice<u8> buf){
+	return crc32_bytewise_ex(0, buf.data, buf.len);
+}
+
+u32 crc32_slice8(Slice<u8> buf){
+	auto const& lut = crc32_lut_sliced;
+	u8 const* p = buf.data;
+	usize n = buf.len;
+	u32 remainder = 0;
+
+	for(; n >= 8; n -= 8, p += 8){
+		u32 hi = remainder ^ crc32_load_be32(p);
+		u32 lo = crc32_load_be32(p + 4);
+		remainder =
+			lut[7][hi >> 24] ^ lut[6][(hi >> 16) & 0xff] ^ lut[5][(hi >> 8) & 0xff] ^ lut[4][hi & 0xff] ^
+			lut[3][lo >> 24] ^ lut[2][(lo >> 16) & 0xff] ^ lut[1][(lo >> 8) & 0xff] ^ lut[0][lo & 0xff];
+	}
+
+	return crc32_bytewise_ex(remainder, p, n);
+}
+
+static
+u32 crc32_slice16_ex(u32 remainder, u8 const* p, usize n){
+	auto const& lut = crc32_lut_sliced;
+
+	for(; n >= 16; n -= 16, p += 16){
+		u32 w0 = remainder ^ crc32_load_be32(p);
+		u32 w1 = crc32_load_be32(p + 4);
+		u32 w2 = crc32_load_be32(p + 8);
+		u32 w3 = crc32_load_be32(p + 12);
+		remainder =
+			lut[15][w0 >> 24] ^ lut[14][(w0 >> 16) & 0xff] ^ lut[13][(w0 >> 8) & 0xff] ^ lut[12][w0 & 0xff] ^
+			lut[11][w1 >> 24] ^ lut[10][(w1 >> 16) & 0xff] ^ lut[9][(w1 >> 8) & 0xff]  ^ lut[8][w1 & 0xff]  ^
+			lut[7][w2 >> 24]  ^ lut[6][(w2 >> 16) & 0xff]  ^ lut[5][(w2 >> 8) & 0xff]  ^ lut[4][w2 & 0xff]  ^
+			lut[3][w3 >> 24]  ^ lut[2][(w3 >> 16) & 0xff]  ^ lut[1][(w3 >> 8) & 0xff]  ^ lut[0][w3 & 0xff];
+	}
+
+	return crc32_bytewise_ex(remainder, p, n);
+}
+
+u32 crc32_slice16(Slice<u8> buf){
+	return crc32_slice16_ex(0, buf.data, buf.len);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+/* Carry-less multiply folding. Blocks are byte swapped so that a 128 bit lane holds the message
+ * polynomial with its highest degree term in the top bit, then each block B is moved forward by D
+ * bits as B.hi * (x^(D+64) mod P) ^ B.lo * (x^D mod P), which keeps it congruent modulo P. Once the
+ * input is folded into a single block its remainder is taken with the table, since the CRC of a
+ * message only depends on the message modulo P. */
+
+#define CRC32_PCLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+#define CRC32_VPCLMUL_TARGET __attribute__((target("pclmul,ssse3,avx512f,avx512bw,vpclmulqdq")))
+
+CRC32_PCLMUL_TARGET static inline
+__m128i crc32_fold_128(__m128i x, __m128i k){
+	return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+CRC32_PCLMUL_TARGET static inline
+__m128i crc32_fold_k128(usize d){
+	return _mm_set_epi64x((long long)crc32_fold_k[d][1], (long long)crc32_fold_k[d][0]);
+}
+
+CRC32_PCLMUL_TARGET static inline
+__m128i crc32_load_128(u8 const* p){
+	const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	return _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)p), bswap);
+}
+
+/* Reduce the last folded block and any trailing bytes */
+CRC32_PCLMUL_TARGET static inline
+u32 crc32_fold_finish(__m128i x, u8 const* p, usize n){
+	const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	u8 block[16];
+	_mm_storeu_si128((__m128i*)block, _mm_shuffle_epi8(x, bswap));
+	u32 remainder = crc32_slice16_ex(0, block, 16);
+	return crc32_slice16_ex(remainder, p, n);
+}
+
+CRC32_PCLMUL_TARGET static
+u32 crc32_pclmul_ex(u32 remainder, u8 const* p, usize n){
+	if(n < 128){
+		return crc32_slice16_ex(remainder, p, n);
+	}
+
+	__m128i x0 = _mm_xor_si128(crc32_load_128(p), _mm_set_epi32(int(remainder), 0, 0, 0));
+	__m128i x1 = crc32_load_128(p + 16);
+	__m128i x2 = crc32_load_128(p + 32);
+	__m128i x3 = crc32_load_128(p + 48);
+	p += 64; n -= 64;
+
+	__m128i k4 = crc32_fold_k128(4);
+	for(; n >= 64; n -= 64, p += 64){
+		x0 = _mm_xor_si128(crc32_fold_128(x0, k4), crc32_load_128(p));
+		x1 = _mm_xor_si128(crc32_fold_128(x1, k4), crc32_load_128(p + 16));
+		x2 = _mm_xor_si128(crc32_fold_128(x2, k4), crc32_load_128(p + 32));
+		x3 = _mm_xor_si128(crc32_fold_128(x3, k4), crc32_load_128(p + 48));
+	}
+
+	__m128i x = _mm_xor_si128(
+		_mm_xor_si128(crc32_fold_128(x0, crc32_fold_k128(3)), crc32_fold_128(x1, crc32_fold_k128(2))),
+		_mm_xor_si128(crc32_fold_128(x2, crc32_fold_k128(1)), x3));
+
+	__m128i k1 = crc32_fold_k128(1);
+	for(; n >= 16; n -= 16, p += 16){
+		x = _mm_xor_si128(crc32_fold_128(x, k1), crc32_load_128(p));
+	}
+
+	return crc32_fold_finish(x, p, n);
+}
+
+CRC32_VPCLMUL_TARGET static inline
+__m512i crc32_fold_512(__m512i x, __m512i k, __m512i data){
+	/* 0x96 is a three way xor */
+	return _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(x, k, 0x00), _mm512_clmulepi64_epi128(x, k, 0x11), data, 0x96);
+}
+
+CRC32_VPCLMUL_TARGET static inline
+__m512i crc32_fold_k512(usize d){
+	return _mm512_set4_epi64((long long)crc32_fold_k[d][1], (long long)crc32_fold_k[d][0], (long long)crc32_fold_k[d][1], (long long)crc32_fold_k[d][0]);
+}
+
+CRC32_VPCLMUL_TARGET static inline
+__m512i crc32_load_512(u8 const* p){
+	const __m512i bswap = _mm512_set4_epi32(0x00010203, 0x04050607, 0x08090a0b, 0x0c0d0e0f);
+	return _mm512_shuffle_epi8(_mm512_loadu_si512((void const*)p), bswap);
+}
+
+CRC32_VPCLMUL_TARGET static
+u32 crc32_vpclmul_ex(u32 remainder, u8 const* p, usize n){
+	if(n < 512){
+		return crc32_pclmul_ex(remainder, p, n);
+	}
+
+	__m512i seed = _mm512_inserti32x4(_mm512_setzero_si512(), _mm_set_epi32(int(remainder), 0, 0, 0), 0);
+	__m512i z0 = _mm512_xor_si512(crc32_load_512(p), seed);
+	__m512i z1 = crc32_load_512(p + 64);
+	__m512i z2 = crc32_load_512(p + 128);
+	__m512i z3 = crc32_load_512(p + 192);
+	p += 256; n -= 256;
+
+	__m512i k16 = crc32_fold_k512(16);
+	for(; n >= 256; n -= 256, p += 256){
+		z0 = crc32_fold_512(z0, k16, crc32_load_512(p));
+		z1 = crc32_fold_512(z1, k16, crc32_load_512(p + 64));
+		z2 = crc32_fold_512(z2, k16, crc32_load_512(p + 128));
+		z3 = crc32_fold_512(z3, k16, crc32_load_512(p + 192));
+	}
+
+	__m512i z = crc32_fold_512(z0, crc32_fold_k512(12), z3);
+	z = crc32_fold_512(z1, crc32_fold_k512(8), z);
+	z = crc32_fold_512(z2, crc32_fold_k512(4), z);
+
+	__m512i k4 = crc32_fold_k512(4);
+	for(; n >= 64; n -= 64, p += 64){
+		z = crc32_fold_512(z, k4, crc32_load_512(p));
+	}
+
+	__m128i lanes[4];
+	_mm512_storeu_si512((void*)lanes, z);
+	__m128i x = _mm_xor_si128(
+		_mm_xor_si128(crc32_fold_128(lanes[0], crc32_fold_k128(3)), crc32_fold_128(lanes[1], crc32_fold_k128(2))),
+		_mm_xor_si128(crc32_fold_128(lanes[2], crc32_fold_k128(1)), lanes[3]));
+
+	__m128i k1 = crc32_fold_k128(1);
+	for(; n >= 16; n -= 16, p += 16){
+		x = _mm_xor_si128(crc32_fold_128(x, k1), crc32_load_128(p));
+	}
+
+	return crc32_fold_finish(x, p, n);
+}
+
+u32 crc32_pclmul(Slice<u8> buf){
+	ensure(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3), "CPU does not support PCLMULQDQ");
+	return crc32_pclmul_ex(0, buf.data, buf.len);
+}
+
+u32 crc32_vpclmul(Slice<u8> buf){
+	ensure(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3 | CPUFeature_AVX512F | CPUFeature_AVX512BW | CPUFeature_VPCLMULQDQ), "CPU does not support VPCLMULQDQ");
+	return crc32_vpclmul_ex(0, buf.data, buf.len);
+}
+#endif
+
+using CRC32Proc = u32 (*)(u32 remainder, u8 const* p, usize n);
+
+struct CRC32Impl {
+	CRC32Proc proc;
+	cstring   name;
+};
+
+static
+CRC32Impl crc32_select(){
+#if defined(__x86_64__) || defined(__i386__)
+	if(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3 | CPUFeature_AVX512F | CPUFeature_AVX512BW | CPUFeature_VPCLMULQDQ)){
+		return { crc32_vpclmul_ex, "vpclmulqdq" };
+	}
+	if(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3)){
+		return { crc32_pclmul_ex, "pclmulqdq" };
+	}
+#endif
+	return { crc32_slice16_ex, "slice16" };
+}
+
+/* Selected once during static initialization */
+static const CRC32Impl crc32_impl = crc32_select();
+
+cstring crc32_implementation(){
+	return crc32_impl.name;
+}
+
+u32 crc32(Slice<u8> buf){
+	return crc32_impl.proc(0, buf.data, buf.len);
+}
+
+CRC32_State crc32_begin(){
+	return CRC32_State{ 0 };
+}
+
+void crc32_update(CRC32_State* state, Slice<u8> buf){
+	state->remainder = crc32_impl.proc(state->remainder, buf.data, buf.len);
+}
+
+u32 crc32_finish(CRC32_State* state){
+	return state->remainder;
+}
+
+static
+u32 crc32_multmodp(u32 a, u32 b){
+	u32 product = 0;
+	for(i32 bit = 31; bit >= 0; bit -= 1){
+		product = (product & 0x80000000) ? ((product << 1) ^ CRC32_POLYNOMIAL) : (product << 1);
+		if((b >> bit) & 1){
+			product ^= a;
+		}
+	}
+	return product;
+}
+
+/* x^(8n) mod P */
+static
+u32 crc32_xpow8(u64 n){
+	u32 result = 1;
+	for(usize k = 0; n != 0; n >>= 1, k += 1){
+		if(n & 1){
+			result = crc32_multmodp(result, crc32_xpow8n[k]);
+		}
+	}
+	return result;
+}
+
+u32 crc32_combine(u32 crc_a, u32 crc_b, usize len_b){
+	/* With a zero initial value and no final xor CRC is linear: CRC(A || B) = CRC(A) * x^(8 len(B)) + CRC(B) */
+	return crc32_multmodp(crc_a, crc32_xpow8(len_b)) ^ crc_b;
+}
+
+constexpr usize CRC32_PARALLEL_MIN_CHUNK = 256 * 1024;
+constexpr usize CRC32_PARALLEL_MAX_CHUNKS = 256;
+
+struct CRC32_Chunk {
+	Slice<u8> data;
+	u32 crc;
+};
+
+static
+void crc32_chunk_task(void* arg){
+	auto chunk = (CRC32_Chunk*)arg;
+	chunk->crc = crc32(chunk->data);
+}
+
+u32 crc32_parallel(Scheduler* sched, Slice<u8> buf){
+	usize chunk_count = min(CRC32_PARALLEL_MAX_CHUNKS, min(sched->workers.len * 4, buf.len / CRC32_PARALLEL_MIN_CHUNK));
+	if(chunk_count <= 1){
+		return crc32(buf);
+	}
+
+	CRC32_Chunk chunks[CRC32_PARALLEL_MAX_CHUNKS];
+	usize chunk_size = (buf.len + chunk_count - 1) / chunk_count;
+
+	TaskGroup group = {};
+	for(usize i = 0; i < chunk_count; i += 1){
+		usize start = i * chunk_size;
+		usize end = min(buf.len, start + chunk_size);
+		chunks[i] = CRC32_Chunk{ slice(buf, start, end), 0 };
+		if(!sched_submit(sched, &group, crc32_chunk_task, &chunks[i])){
+			crc32_chunk_task(&chunks[i]);
+		}
+	}
+	sched_wait(sched, &group);
+
+	u32 result = chunks[0].crc;
+	for(usize i = 1; i < chunk_count; i += 1){
+		result = crc32_combine(result, chunks[i].crc, chunks[i].data.len);
+	}
+	return result;
+}
+
+bool crc32_file(String path, u32* crc){
+	/* Mapped files are hashed in place, anything else is streamed through a fixed buffer */
+	Slice<u8> data = file_map(path, FileMapHint_Sequential);
+	if(data.data){
+		*crc = crc32(data);
+		file_unmap(data);
+		return true;
+	}
+
+	ChunkReader r;
+	if(!chunk_reader_open(&r, path)){ return false; }
+	auto buf = make_slice_uninit<u8>(heap_allocator(), CHUNK_READER_SIZE);
+	if(!buf.data){
+		chunk_reader_close(&r);
+		return false;
+	}
+
+	CRC32_State state = crc32_begin();
+	for(usize n = chunk_read(&r, buf); n > 0; n = chunk_read(&r, buf)){
+		crc32_update(&state, take(buf, n));
+	}
+	bool ok = !r.failed;
+	chunk_reader_close(&r);
+	mem_free(heap_allocator(), buf.data, buf.len, 1);
 
-    return remainder;
+	*crc = crc32_finish(&state);
+	return ok;
 }
@@ -0,0 +1,109 @@
+static inline
+u32 crc32c_load_le32(u8 const* p){
+	return u32(p[0]) | (u32(p[1]) << 8) | (u32(p[2]) << 16) | (u32(p[3]) << 24);
+}
+
+/* Operates on the raw register, pre and post conditioning is done by the callers */
+static
+u32 crc32c_slice8_ex(u32 remainder, u8 const* p, usize n){
+	auto const& lut = crc32c_lut_sliced;
+
+	for(; n >= 8; n -= 8, p += 8){
+		u32 lo = remainder ^ crc32c_load_le32(p);
+		u32 hi = crc32c_load_le32(p + 4);
+		remainder =
+			lut[7][lo & 0xff] ^ lut[6][(lo >> 8) & 0xff] ^ lut[5][(lo >> 16) & 0xff] ^ lut[4][lo >> 24] ^
+			lut[3][hi & 0xff] ^ lut[2][(hi >> 8) & 0xff] ^ lut[1][(hi >> 16) & 0xff] ^ lut[0][hi >> 24];
+	}
+
+	for(; n > 0; n -= 1, p += 1){
+		remainder = crc32c_lut[(remainder ^ *p) & 0xff] ^ (remainder >> 8);
+	}
+
+	return remainder;
+}
+
+u32 crc32c_slice8(Slice<u8> buf){
+	return ~crc32c_slice8_ex(~u32(0), buf.data, buf.len);
+}
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+static inline
+u32 crc32c_shift(u32 const (*shift)[256], u32 remainder){
+	return shift[0][remainder & 0xff] ^ shift[1][(remainder >> 8) & 0xff] ^
+	       shift[2][(remainder >> 16) & 0xff] ^ shift[3][remainder >> 24];
+}
+
+/* The crc32 instruction has a latency of 3 cycles and a throughput of 1, so three independent
+ * streams over adjacent blocks keep it busy. The partial results are merged by shifting the
+ * running register over a block of zeros with the generated tables. */
+__attribute__((target("sse4.2"))) static
+u32 crc32c_sse42_ex(u32 remainder, u8 const* p, usize n){
+	u64 crc0 = remainder;
+
+	/* Align so the word loads below are aligned */
+	for(; n > 0 && (uintptr(p) & 7); n -= 1, p += 1){
+		crc0 = _mm_crc32_u8(u32(crc0), *p);
+	}
+
+	constexpr usize block_sizes[] = { CRC32C_LONG_BLOCK, CRC32C_SHORT_BLOCK };
+	constexpr u32 const (*block_shifts[])[256] = { crc32c_shift_long, crc32c_shift_short };
+
+	for(usize b = 0; b < 2; b += 1){
+		usize block = block_sizes[b];
+		for(; n >= block * 3; n -= block * 3){
+			u64 crc1 = 0;
+			u64 crc2 = 0;
+			u8 const* end = p + block;
+			for(; p < end; p += 8){
+				crc0 = _mm_crc32_u64(crc0, *(u64 const*)p);
+				crc1 = _mm_crc32_u64(crc1, *(u64 const*)(p + block));
+				crc2 = _mm_crc32_u64(crc2, *(u64 const*)(p + block * 2));
+			}
+			crc0 = crc32c_shift(block_shifts[b], u32(crc0)) ^ crc1;
+			crc0 = crc32c_shift(block_shifts[b], u32(crc0)) ^ crc2;
+			p += block * 2;
+		}
+	}
+
+	for(; n >= 8; n -= 8, p += 8){
+		crc0 = _mm_crc32_u64(crc0, *(u64 const*)p);
+	}
+
+	for(; n > 0; n -= 1, p += 1){
+		crc0 = _mm_crc32_u8(u32(crc0), *p);
+	}
+
+	return u32(crc0);
+}
+
+u32 crc32c_sse42(Slice<u8> buf){
+	ensure(cpu_has(CPUFeature_SSE42), "CPU does not support SSE4.2");
+	return ~crc32c_sse42_ex(~u32(0), buf.data, buf.len);
+}
+#endif
+
+using CRC32CProc = u32 (*)(u32 remainder, u8 const* p, usize n);
+
+static
+CRC32CProc crc32c_select(){
+#if defined(__x86_64__)
+	if(cpu_has(CPUFeature_SSE42)){
+		return crc32c_sse42_ex;
+	}
+#endif
+	return crc32c_slice8_ex;
+}
+
+/* Selected once during static initialization */
+static const CRC32CProc crc32c_impl = crc32c_select();
+
+u32 crc32c(Slice<u8> buf){
+	return ~crc32c_impl(~u32(0), buf.data, buf.len);
+}
+
+u32 crc32c_update(u32 crc, Slice<u8> buf){
+	return ~crc32c_impl(~crc, buf.data, buf.len);
+}
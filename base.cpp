@@ -4,12 +4,28 @@
 #include "vendor/stb_sprintf.h"
 
 //// Basic types & utilities
+/* Aligned loads never cross a page boundary, so reading the rest of the block that holds the
+ * terminator cannot fault. Address sanitizer does not know that. */
+__attribute__((no_sanitize_address))
 usize cstring_len(cstring cs) {
+#if defined(__SSE2__)
+	uintptr misalign = uintptr(cs) & 15;
+	auto p = (__m128i const*)(uintptr(cs) - misalign);
+	__m128i zero = _mm_setzero_si128();
+	u32 mask = u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(p), zero))) >> misalign;
+	while(mask == 0){
+		p += 1;
+		mask = u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(p), zero)));
+		misalign = 0;
+	}
+	return usize((char const*)p - cs) + misalign + usize(__builtin_ctz(mask));
+#else
 	usize n = 0;
 	while(cs[n] != 0){
 		n += 1;
 	}
 	return n;
+#endif
 }
 
 //// Assertions
@@ -25,12 +41,21 @@ void panic_ex(char const* msg, char const* filename, int line){
 
 bool ensure_ex(bool pred, char const* msg, char const* filename, int line){
 	if(!pred){
-		fprintf(stderr, "(%s:%d) Assertion failed: %s\n", filename, line, msg);
-		abort();
+		ensure_fail(msg, filename, line);
 	}
 	return pred;
 }
 
+void ensure_fail(char const* msg, char const* filename, int line){
+	fprintf(stderr, "(%s:%d) Assertion failed: %s\n", filename, line, msg);
+	abort();
+}
+
+void bounds_check_fail(usize idx, usize len, char const* filename, int line){
+	fprintf(stderr, "(%s:%d) Out of bounds access: index %zu, length %zu\n", filename, line, idx, len);
+	abort();
+}
+
 //// Memory
 extern "C" {
 	void* memmove(void* dest, void const* src, size_t n);
@@ -59,6 +84,53 @@ isize mem_compare(void const* lhs, void const* rhs, isize n){
 	return memcmp(lhs, rhs, n);
 }
 
+static inline
+u64 mem_load8(u8 const* p){
+	u64 v;
+	__builtin_memcpy(&v, p, 8);
+	return v;
+}
+
+static inline
+u32 mem_load4(u8 const* p){
+	u32 v;
+	__builtin_memcpy(&v, p, 4);
+	return v;
+}
+
+/* Short inputs compare two overlapping words covering the whole range, longer ones whole blocks
+ * plus one overlapping block for the tail */
+bool mem_equal(void const* lhs, void const* rhs, usize n){
+	auto a = (u8 const*)lhs;
+	auto b = (u8 const*)rhs;
+	if(a == b){ return true; }
+
+	if(n < 16){
+		if(n >= 8){
+			return ((mem_load8(a) ^ mem_load8(b)) | (mem_load8(a + n - 8) ^ mem_load8(b + n - 8))) == 0;
+		}
+		if(n >= 4){
+			return ((mem_load4(a) ^ mem_load4(b)) | (mem_load4(a + n - 4) ^ mem_load4(b + n - 4))) == 0;
+		}
+		if(n == 0){ return true; }
+		/* 1 to 3 bytes: first, middle and last */
+		return ((a[0] ^ b[0]) | (a[n >> 1] ^ b[n >> 1]) | (a[n - 1] ^ b[n - 1])) == 0;
+	}
+
+#if defined(__SSE2__)
+	for(usize i = 0; i + 16 < n; i += 16){
+		__m128i x = _mm_loadu_si128((__m128i const*)(a + i));
+		__m128i y = _mm_loadu_si128((__m128i const*)(b + i));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xffff){ return false; }
+	}
+	__m128i x = _mm_loadu_si128((__m128i const*)(a + n - 16));
+	__m128i y = _mm_loadu_si128((__m128i const*)(b + n - 16));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xffff;
+#else
+	return memcmp(a, b, n) == 0;
+#endif
+}
+
 uintptr mem_align_forward_ptr(uintptr p, uintptr a){
 	ensure(mem_valid_alignment(a), "Alignment must be a power of 2 greater than 0");
 	uintptr mod = p & (a - 1); /* Fast modulo for powers of 2 */
@@ -69,10 +141,42 @@ uintptr mem_align_forward_ptr(uintptr p, uintptr a){
 }
 
 //// Arena
+constexpr usize ARENA_COMMIT_GRANULARITY = 64 * 1024;
+constexpr usize ARENA_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static
+usize arena_commit_granularity(Arena* a){
+	return (a->flags & ArenaFlag_HugePages) ? ARENA_HUGE_PAGE_SIZE : ARENA_COMMIT_GRANULARITY;
+}
+
+/* Make sure [0, end) is usable, committing more pages for virtual arenas */
+static
+bool arena_ensure_committed(Arena* a, usize end){
+	if(end <= a->committed){ return true; }
+	if(end > a->capacity || !(a->flags & ArenaFlag_Virtual)){ return false; }
+
+	usize new_committed = min(a->capacity, usize(mem_align_forward_ptr(end, arena_commit_granularity(a))));
+	void* start = (void*)((uintptr)a->data + a->committed);
+	if(!os_mem_commit(start, new_committed - a->committed)){
+		return false;
+	}
+	a->committed = new_committed;
+	return true;
+}
+
 void arena_reset(Arena* a){
 	ensure(a->region_count == 0, "Arena has dangling regions");
 	a->offset = 0;
 	a->last_allocation = nullptr;
+
+	if((a->flags & ArenaFlag_Virtual) && (a->flags & ArenaFlag_DecommitOnReset)){
+		/* Keep the first granule around so small arenas do not thrash */
+		usize keep = min(a->committed, arena_commit_granularity(a));
+		if(a->committed > keep){
+			os_mem_decommit((void*)((uintptr)a->data + keep), a->committed - keep);
+			a->committed = keep;
+		}
+	}
 }
 
 bool arena_owns(Arena* a, void* p){
@@ -83,7 +187,7 @@ bool arena_owns(Arena* a, void* p){
 	return (ptr >= lo) && (ptr <= hi);
 }
 
-void* arena_alloc(Arena* a, usize size, usize align){
+void* arena_alloc_uninit(Arena* a, usize size, usize align){
 	if(size == 0){ return nullptr; }
 	uintptr base = (uintptr)a->data;
 	uintptr current = base + (uintptr)a->offset;
@@ -97,35 +201,27 @@ void* arena_alloc(Arena* a, usize size, usize align){
 	if(required > available){
 		return nullptr; /* Out of memory */
 	}
+	if(!arena_ensure_committed(a, a->offset + required)){
+		return nullptr; /* Could not commit */
+	}
 
 	a->offset += required;
 	void* allocation = (void*)aligned;
 	a->last_allocation = allocation;
-	mem_zero(allocation, size);
 
 	return allocation;
 }
 
-void* arena_realloc(Arena* a, void* ptr, usize old_size, usize new_size, usize align){
-	if(ptr == nullptr){
-		return arena_alloc(a, new_size, align);
-	}
-	ensure(arena_owns(a, ptr), "Pointer not owned by arena");
-
-	bool in_place = arena_resize(a, ptr, new_size);
-	if(in_place){
-		return ptr;
-	}
-	else {
-		void* new_data = arena_alloc(a, new_size, align);
-		if(new_data == nullptr){ return nullptr; } /* Out of memory */
-		mem_copy(new_data, ptr, min(old_size, new_size));
-
-		return new_data;
+void* arena_alloc(Arena* a, usize size, usize align){
+	void* allocation = arena_alloc_uninit(a, size, align);
+	if(allocation){
+		mem_zero(allocation, size);
 	}
+	return allocation;
 }
 
-bool arena_resize(Arena* a, void* ptr, usize new_size){
+static
+bool arena_resize_ex(Arena* a, void* ptr, usize new_size, bool zero){
 	if(ptr == nullptr){ return false; }
 	ensure(arena_owns(a, ptr), "Pointer not owned by arena");
 
@@ -133,19 +229,54 @@ bool arena_resize(Arena* a, void* ptr, usize new_size){
 
 	if(ptr == a->last_allocation){
 		uintptr last_alloc = (uintptr)a->last_allocation;
+		uintptr old_end = base + a->offset;
 
 		if((last_alloc + new_size) > (base + a->capacity)){
 			return false; /* No space left */
 		}
+		if(!arena_ensure_committed(a, (last_alloc + new_size) - base)){
+			return false;
+		}
 
 		a->offset = (last_alloc + new_size) - base;
-		// TODO: fill excess with 0s when increasing the allocation size
+		if(zero && (last_alloc + new_size) > old_end){
+			mem_zero((void*)old_end, (last_alloc + new_size) - old_end);
+		}
 		return true;
 	}
 
 	return false;
 }
 
+static
+void* arena_realloc_ex(Arena* a, void* ptr, usize old_size, usize new_size, usize align, bool zero){
+	if(ptr == nullptr){
+		return zero ? arena_alloc(a, new_size, align) : arena_alloc_uninit(a, new_size, align);
+	}
+	ensure(arena_owns(a, ptr), "Pointer not owned by arena");
+
+	if(arena_resize_ex(a, ptr, new_size, zero)){
+		return ptr;
+	}
+
+	void* new_data = arena_alloc_uninit(a, new_size, align);
+	if(new_data == nullptr){ return nullptr; } /* Out of memory */
+	mem_copy(new_data, ptr, min(old_size, new_size));
+	if(zero && new_size > old_size){
+		mem_zero((void*)(uintptr(new_data) + old_size), new_size - old_size);
+	}
+
+	return new_data;
+}
+
+void* arena_realloc(Arena* a, void* ptr, usize old_size, usize new_size, usize align){
+	return arena_realloc_ex(a, ptr, old_size, new_size, align, true);
+}
+
+bool arena_resize(Arena* a, void* ptr, usize new_size){
+	return arena_resize_ex(a, ptr, new_size, true);
+}
+
 Arena arena_from_buffer(Slice<u8> buf){
 	Arena a;
 	a.data = (void*)buf.data;
@@ -153,9 +284,57 @@ Arena arena_from_buffer(Slice<u8> buf){
 	a.capacity = buf.len;
 	a.last_allocation = nullptr;
 	a.region_count = 0;
+	a.flags = 0;
+	a.committed = buf.len;
+	return a;
+}
+
+Arena arena_create_virtual(usize reserve, u32 flags){
+	Arena a = {};
+	flags |= ArenaFlag_Virtual;
+	usize granularity = (flags & ArenaFlag_HugePages) ? ARENA_HUGE_PAGE_SIZE : ARENA_COMMIT_GRANULARITY;
+	reserve = mem_align_forward_ptr(reserve, granularity);
+
+	void* data = nullptr;
+#if defined(_WIN32)
+	/* VirtualFree can only release a whole reservation so the slack cannot be trimmed, and huge
+	 * pages are never used there anyway. The 2 MiB commit steps are kept. */
+	data = os_mem_reserve(reserve);
+#else
+	if(flags & ArenaFlag_HugePages){
+		/* Over-reserve so the range can be aligned to a huge page boundary, then trim the slack */
+		uintptr raw = (uintptr)os_mem_reserve(reserve + ARENA_HUGE_PAGE_SIZE);
+		if(raw){
+			uintptr aligned = mem_align_forward_ptr(raw, ARENA_HUGE_PAGE_SIZE);
+			usize head = aligned - raw;
+			usize tail = ARENA_HUGE_PAGE_SIZE - head;
+			if(head){ os_mem_release((void*)raw, head); }
+			if(tail){ os_mem_release((void*)(aligned + reserve), tail); }
+			data = (void*)aligned;
+			os_mem_advise_huge_pages(data, reserve);
+		}
+	}
+	else {
+		data = os_mem_reserve(reserve);
+	}
+#endif
+
+	if(!data){ return a; }
+
+	a.data = data;
+	a.capacity = reserve;
+	a.flags = flags;
 	return a;
 }
 
+void arena_destroy(Arena* a){
+	ensure(a->flags & ArenaFlag_Virtual, "Only virtual arenas own their memory");
+	if(a->data){
+		os_mem_release(a->data, a->capacity);
+	}
+	*a = Arena{};
+}
+
 ArenaRegion arena_region_begin(Arena* a){
 	ArenaRegion reg = {
 		.arena = a,
@@ -187,8 +366,16 @@ void* arena_allocator_func(void* data, AllocatorMode mode, void* ptr, usize old_
 		result = arena_realloc(arena, ptr, old_size, new_size, align);
 	break;
 
+	case AllocatorMode_AllocUninit:
+		result = arena_alloc_uninit(arena, new_size, align);
+	break;
+
+	case AllocatorMode_ReallocUninit:
+		result = arena_realloc_ex(arena, ptr, old_size, new_size, align, false);
+	break;
+
 	case AllocatorMode_Free:
-		arena_resize(arena, ptr, 0);
+		arena_resize_ex(arena, ptr, 0, false);
 	break;
 
 	case AllocatorMode_FreeAll:
@@ -227,7 +414,7 @@ String skip(String s, usize count) {
 
 String clone(Allocator allocator, String s){
 	String res = {};
-	auto buf = make_slice<u8>(allocator, s.len);
+	auto buf = make_slice_uninit<u8>(allocator, s.len);
 	if(buf.data == nullptr){ return res; }
 	mem_copy_no_overlap(buf.data, s.data, s.len);
 
@@ -238,7 +425,7 @@ String clone(Allocator allocator, String s){
 }
 
 cstring clone_to_cstring(String s, Arena* a){
-	auto buf = make_slice<u8>(a, s.len + 1);
+	auto buf = make_slice_uninit<u8>(a, s.len + 1);
 	if(buf.data){
 		mem_copy(buf.data, s.data, s.len);
 		buf.data[s.len] = 0;
@@ -380,9 +567,24 @@ RuneEncoded rune_encode(rune r){
 
 String arena_vprintf(Arena* arena, char const* fmt, va_list args){
 	void* base = (void*)((uintptr)arena->data + arena->offset);
-	usize size = arena->capacity - arena->offset;
+	usize available = arena->committed - arena->offset;
+
+	va_list retry;
+	va_copy(retry, args);
+	/* With no room left only measure, stb writes the terminator at buf[count - 1] otherwise */
+	int n = stbsp_vsnprintf(available ? (char*)base : nullptr, int(min<usize>(available, 0x7fffffff)), fmt, args);
+
+	if(n > 0 && usize(n) + 1 > available){
+		/* Did not fit in the committed pages, grow them and format again */
+		if(arena_ensure_committed(arena, arena->offset + usize(n) + 1)){
+			n = stbsp_vsnprintf((char*)base, n + 1, fmt, retry);
+		}
+		else {
+			n = 0;
+		}
+	}
+	va_end(retry);
 
-	int n = stbsp_vsnprintf((char*)base, size - 1, fmt, args);
 	if(n > 0){
 		arena->offset += n + 1; /* Account for nullptr terminator */
 		return String((char const*)base, n);
@@ -399,56 +601,2236 @@ String arena_printf(Arena* arena, char const* fmt, ...){
 }
 
 
-extern "C"{
-	void* malloc(size_t);
-	void* realloc(void*, size_t);
-	void free(void*);
+//// String search
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+/* Checked during static initialization, calls made before that take the SSE2 path */
+static const bool string_search_avx2 = cpu_has(CPUFeature_AVX2);
+
+constexpr usize STRING_SEARCH_AVX2_MIN = 64;
+
+__attribute__((target("avx2"))) static
+isize index_byte_avx2(u8 const* p, usize n, u8 b){
+	__m256i needle = _mm256_set1_epi8(char(b));
+	usize i = 0;
+	for(; i + 64 <= n; i += 64){
+		__m256i x = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p + i)), needle);
+		__m256i y = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p + i + 32)), needle);
+		u64 mask = u64(u32(_mm256_movemask_epi8(x))) | (u64(u32(_mm256_movemask_epi8(y))) << 32);
+		if(mask){ return isize(i) + __builtin_ctzll(mask); }
+	}
+	for(; i + 32 <= n; i += 32){
+		u32 mask = u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p + i)), needle)));
+		if(mask){ return isize(i) + __builtin_ctz(mask); }
+	}
+	if(i < n){
+		/* Overlapping last block, n is at least 32 here */
+		usize last = n - 32;
+		u32 mask = u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p + last)), needle)));
+		mask &= ~u32(0) << (i - last);
+		if(mask){ return isize(last) + __builtin_ctz(mask); }
+	}
+	return -1;
 }
 
-//// Heap
+__attribute__((target("avx2"))) static
+isize last_index_byte_avx2(u8 const* p, usize n, u8 b){
+	__m256i needle = _mm256_set1_epi8(char(b));
+	usize i = n;
+	for(; i >= 32; i -= 32){
+		u32 mask = u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p + i - 32)), needle)));
+		if(mask){ return isize(i) - 32 + (31 - __builtin_clz(mask)); }
+	}
+	if(i > 0){
+		/* Overlapping first block, only the lowest i bytes are new */
+		u32 mask = u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)p), needle)));
+		mask &= ~u32(0) >> (32 - i);
+		if(mask){ return 31 - __builtin_clz(mask); }
+	}
+	return -1;
+}
+
+/* Candidates must match both the first and the last byte of `sub`, only those are compared fully */
+__attribute__((target("avx2"))) static
+isize find_avx2(u8 const* p, usize n, u8 const* sub, usize m){
+	__m256i first = _mm256_set1_epi8(char(sub[0]));
+	__m256i last = _mm256_set1_epi8(char(sub[m - 1]));
+	usize i = 0;
+	for(; i + m - 1 + 32 <= n; i += 32){
+		__m256i x = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p + i)), first);
+		__m256i y = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p + i + m - 1)), last);
+		u32 mask = u32(_mm256_movemask_epi8(_mm256_and_si256(x, y)));
+		while(mask){
+			usize pos = i + usize(__builtin_ctz(mask));
+			if(mem_equal(p + pos + 1, sub + 1, m - 2)){ return isize(pos); }
+			mask &= mask - 1;
+		}
+	}
+	for(; i + m <= n; i += 1){
+		if(p[i] == sub[0] && p[i + m - 1] == sub[m - 1] && mem_equal(p + i + 1, sub + 1, m - 2)){ return isize(i); }
+	}
+	return -1;
+}
+#endif
+
+isize index_byte(String s, u8 b){
+	auto p = (u8 const*)s.data;
+	usize n = s.len;
+#if defined(__x86_64__)
+	if(n >= STRING_SEARCH_AVX2_MIN && string_search_avx2){
+		return index_byte_avx2(p, n, b);
+	}
+#endif
+	usize i = 0;
+#if defined(__SSE2__)
+	__m128i needle = _mm_set1_epi8(char(b));
+	for(; i + 16 <= n; i += 16){
+		u32 mask = u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p + i)), needle)));
+		if(mask){ return isize(i) + __builtin_ctz(mask); }
+	}
+	if(i < n && n >= 16){
+		usize last = n - 16;
+		u32 mask = u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p + last)), needle)));
+		mask &= ~u32(0) << (i - last);
+		return mask ? isize(last) + __builtin_ctz(mask) : -1;
+	}
+#endif
+	for(; i < n; i += 1){
+		if(p[i] == b){ return isize(i); }
+	}
+	return -1;
+}
+
+isize last_index_byte(String s, u8 b){
+	auto p = (u8 const*)s.data;
+	usize n = s.len;
+#if defined(__x86_64__)
+	if(n >= STRING_SEARCH_AVX2_MIN && string_search_avx2){
+		return last_index_byte_avx2(p, n, b);
+	}
+#endif
+	usize i = n;
+#if defined(__SSE2__)
+	__m128i needle = _mm_set1_epi8(char(b));
+	for(; i >= 16; i -= 16){
+		u32 mask = u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p + i - 16)), needle)));
+		if(mask){ return isize(i) - 16 + (31 - __builtin_clz(mask)); }
+	}
+	if(i > 0 && n >= 16){
+		u32 mask = u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)p), needle)));
+		mask &= ~u32(0) >> (32 - i);
+		return mask ? 31 - __builtin_clz(mask) : -1;
+	}
+#endif
+	for(; i > 0; i -= 1){
+		if(p[i - 1] == b){ return isize(i) - 1; }
+	}
+	return -1;
+}
+
+isize find(String s, String sub){
+	usize n = s.len;
+	usize m = sub.len;
+	if(m == 0){ return 0; }
+	if(m > n){ return -1; }
+	if(m == 1){ return index_byte(s, u8(sub.data[0])); }
+
+	auto p = (u8 const*)s.data;
+	auto q = (u8 const*)sub.data;
+#if defined(__x86_64__)
+	if(n >= STRING_SEARCH_AVX2_MIN && string_search_avx2){
+		return find_avx2(p, n, q, m);
+	}
+#endif
+	usize i = 0;
+#if defined(__SSE2__)
+	/* Same first and last byte filter as find_avx2 */
+	__m128i first = _mm_set1_epi8(char(q[0]));
+	__m128i last = _mm_set1_epi8(char(q[m - 1]));
+	for(; i + m - 1 + 16 <= n; i += 16){
+		__m128i x = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p + i)), first);
+		__m128i y = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p + i + m - 1)), last);
+		u32 mask = u32(_mm_movemask_epi8(_mm_and_si128(x, y)));
+		while(mask){
+			usize pos = i + usize(__builtin_ctz(mask));
+			if(mem_equal(p + pos + 1, q + 1, m - 2)){ return isize(pos); }
+			mask &= mask - 1;
+		}
+	}
+#endif
+	for(; i + m <= n; i += 1){
+		if(p[i] == q[0] && p[i + m - 1] == q[m - 1] && mem_equal(p + i + 1, q + 1, m - 2)){ return isize(i); }
+	}
+	return -1;
+}
+
+//// UTF-8
+/* Valid prefix scan: a rune_decode loop that skips ASCII 16 bytes at a time, resuming at `i` */
 static
-void* heap_allocator_func(void*, AllocatorMode mode, void* ptr, usize old_size, usize new_size, usize align){
-	void* result = nullptr;
+usize utf8_valid_prefix_scalar(u8 const* p, usize n, usize i){
+	while(i < n){
+#if defined(__SSE2__)
+		if(p[i] < 0x80 && i + 16 <= n){
+			u32 mask = u32(_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)(p + i))));
+			i += mask ? usize(__builtin_ctz(mask)) : 16;
+			continue;
+		}
+#endif
+		RuneDecoded r = rune_decode(p + i, u32(min<usize>(n - i, 4)));
+		/* A correctly encoded U+FFFD is 3 bytes long, errors always have size 1 */
+		if(r.codepoint == RUNE_ERROR && r.size == 1){ return i; }
+		i += r.size;
+	}
+	return n;
+}
 
-	switch(mode){
-	case AllocatorMode_Alloc:
-		if(align > alignof(max_align_t)){ // TODO: Custom alignment
-			return nullptr;
+#if defined(__x86_64__)
+static const bool utf8_avx2 = cpu_has(CPUFeature_AVX2);
+
+/* Error classes of a byte pair (previous byte, current byte), the lookups below tell which
+ * classes each nibble allows and a pair is invalid when all three agree on one. Lemire & Keiser,
+ * "Validating UTF-8 In Less Than One Instruction Per Byte". */
+enum UTF8Error : u8 {
+	UTF8Error_TooShort   = 1 << 0, /* Lead byte not followed by a continuation */
+	UTF8Error_TooLong    = 1 << 1, /* Continuation after ASCII */
+	UTF8Error_Overlong3  = 1 << 2,
+	UTF8Error_TooLarge   = 1 << 3,
+	UTF8Error_Surrogate  = 1 << 4,
+	UTF8Error_Overlong2  = 1 << 5,
+	UTF8Error_TooLarge2  = 1 << 6, /* Above U+10FFFF with a 1000____ second byte, shares its bit with Overlong4 */
+	UTF8Error_Overlong4  = 1 << 6,
+	UTF8Error_TwoConts   = 1 << 7, /* Continuation after continuation, allowed only inside 3 and 4 byte sequences */
+	UTF8Error_Carry      = UTF8Error_TooShort | UTF8Error_TooLong | UTF8Error_TwoConts,
+};
+
+static const u8 utf8_lookup_byte1_high[16] = {
+	UTF8Error_TooLong, UTF8Error_TooLong, UTF8Error_TooLong, UTF8Error_TooLong,
+	UTF8Error_TooLong, UTF8Error_TooLong, UTF8Error_TooLong, UTF8Error_TooLong,
+	UTF8Error_TwoConts, UTF8Error_TwoConts, UTF8Error_TwoConts, UTF8Error_TwoConts,
+	UTF8Error_TooShort | UTF8Error_Overlong2,
+	UTF8Error_TooShort,
+	UTF8Error_TooShort | UTF8Error_Overlong3 | UTF8Error_Surrogate,
+	UTF8Error_TooShort | UTF8Error_TooLarge | UTF8Error_TooLarge2 | UTF8Error_Overlong4,
+};
+
+static const u8 utf8_lookup_byte1_low[16] = {
+	UTF8Error_Carry | UTF8Error_Overlong3 | UTF8Error_Overlong2 | UTF8Error_Overlong4,
+	UTF8Error_Carry | UTF8Error_Overlong2,
+	UTF8Error_Carry,
+	UTF8Error_Carry,
+	UTF8Error_Carry | UTF8Error_TooLarge,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2 | UTF8Error_Surrogate,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+	UTF8Error_Carry | UTF8Error_TooLarge | UTF8Error_TooLarge2,
+};
+
+static const u8 utf8_lookup_byte2_high[16] = {
+	UTF8Error_TooShort, UTF8Error_TooShort, UTF8Error_TooShort, UTF8Error_TooShort,
+	UTF8Error_TooShort, UTF8Error_TooShort, UTF8Error_TooShort, UTF8Error_TooShort,
+	UTF8Error_TooLong | UTF8Error_Overlong2 | UTF8Error_TwoConts | UTF8Error_Overlong3 | UTF8Error_TooLarge2 | UTF8Error_Overlong4,
+	UTF8Error_TooLong | UTF8Error_Overlong2 | UTF8Error_TwoConts | UTF8Error_Overlong3 | UTF8Error_TooLarge,
+	UTF8Error_TooLong | UTF8Error_Overlong2 | UTF8Error_TwoConts | UTF8Error_Surrogate | UTF8Error_TooLarge,
+	UTF8Error_TooLong | UTF8Error_Overlong2 | UTF8Error_TwoConts | UTF8Error_Surrogate | UTF8Error_TooLarge,
+	UTF8Error_TooShort, UTF8Error_TooShort, UTF8Error_TooShort, UTF8Error_TooShort,
+};
+
+/* Bytes that still expect continuations when they are among the last 3 of a block */
+static const u8 utf8_incomplete_max[32] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf,
+};
+
+/* Validates 32 bytes per step, stopping at the first block with an error. The exact position is
+ * found by the scalar scan from the start of the character the block boundary falls in. */
+__attribute__((target("avx2"))) static
+usize utf8_valid_prefix_avx2(u8 const* p, usize n){
+	__m256i byte1_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*)utf8_lookup_byte1_high));
+	__m256i byte1_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*)utf8_lookup_byte1_low));
+	__m256i byte2_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*)utf8_lookup_byte2_high));
+	__m256i incomplete_max = _mm256_loadu_si256((__m256i const*)utf8_incomplete_max);
+	__m256i nibble = _mm256_set1_epi8(0x0f);
+
+	__m256i prev = _mm256_setzero_si256();
+	__m256i prev_incomplete = _mm256_setzero_si256();
+	usize i = 0;
+	for(; i + 32 <= n; i += 32){
+		__m256i input = _mm256_loadu_si256((__m256i const*)(p + i));
+		__m256i error = prev_incomplete;
+		if(_mm256_movemask_epi8(input) == 0){
+			prev_incomplete = _mm256_setzero_si256();
+		}
+		else {
+			/* Previous 1, 2 and 3 bytes of each position, spanning the two blocks */
+			__m256i carry = _mm256_permute2x128_si256(prev, input, 0x21);
+			__m256i prev1 = _mm256_alignr_epi8(input, carry, 15);
+			__m256i prev2 = _mm256_alignr_epi8(input, carry, 14);
+			__m256i prev3 = _mm256_alignr_epi8(input, carry, 13);
+
+			__m256i special = _mm256_and_si256(
+				_mm256_and_si256(
+					_mm256_shuffle_epi8(byte1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+					_mm256_shuffle_epi8(byte1_low, _mm256_and_si256(prev1, nibble))),
+				_mm256_shuffle_epi8(byte2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+			/* Third and fourth bytes of a sequence must be continuations, which is the only case
+			 * where the TwoConts bit of `special` is expected */
+			__m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xe0 - 0x80)));
+			__m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xf0 - 0x80)));
+			__m256i must_continue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+
+			error = _mm256_xor_si256(must_continue, special);
+			prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
 		}
+		if(!_mm256_testz_si256(error, error)){ break; }
+		prev = input;
+	}
 
-		result = malloc(new_size);
-		if(result){
-			mem_zero(result, new_size);
+	/* Characters before `i` are valid but the last one may be incomplete */
+	usize start = i;
+	if(start > 0){
+		start -= 1;
+		while(start > 0 && i - start < 4 && (p[start] & 0xc0) == 0x80){
+			start -= 1;
 		}
-	break;
+	}
+	return utf8_valid_prefix_scalar(p, n, start);
+}
+#endif
 
-	case AllocatorMode_Realloc:
-		if(align > alignof(max_align_t)){ // TODO: Custom alignment
-			return nullptr;
+/* Length of the longest prefix made of complete, valid sequences */
+static
+usize utf8_valid_prefix(u8 const* p, usize n){
+#if defined(__x86_64__)
+	if(n >= 32 && utf8_avx2){
+		return utf8_valid_prefix_avx2(p, n);
+	}
+#endif
+	return utf8_valid_prefix_scalar(p, n, 0);
+}
+
+/* Runes in valid input, plus the runes needing a surrogate pair if `utf16` is set */
+static
+usize utf8_count_valid(u8 const* p, usize n, bool utf16){
+	usize count = 0;
+	usize i = 0;
+#if defined(__SSE2__)
+	/* Continuation bytes are the signed values below -64, 4 byte leads are 0xf0 and up. Matches
+	 * are summed per byte lane and flushed before a lane can overflow. */
+	__m128i cont_max = _mm_set1_epi8(-65);
+	__m128i lead4_min = _mm_set1_epi8(char(0xf0));
+	__m128i zero = _mm_setzero_si128();
+	while(i + 16 <= n){
+		__m128i acc = zero;
+		usize end = min(n - 15, i + 16 * 127);
+		for(; i < end; i += 16){
+			__m128i x = _mm_loadu_si128((__m128i const*)(p + i));
+			acc = _mm_sub_epi8(acc, _mm_cmpgt_epi8(x, cont_max));
+			if(utf16){
+				acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_max_epu8(x, lead4_min), x));
+			}
 		}
+		__m128i sums = _mm_sad_epu8(acc, zero);
+		count += usize(_mm_cvtsi128_si64(sums)) + usize(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+	}
+#endif
+	for(; i < n; i += 1){
+		count += (p[i] & 0xc0) != 0x80;
+		count += utf16 && p[i] >= 0xf0;
+	}
+	return count;
+}
 
-		result = realloc(ptr, new_size);
-		if(result && (new_size > old_size)){
-			uintptr diff = new_size - old_size;
-			void* to_zero = (void*)(uintptr(result) + old_size);
-			mem_zero(to_zero, diff);
+/* Number of UTF-32 or UTF-16 units the decoding of `s` produces */
+static
+usize utf8_decoded_len(String s, bool utf16){
+	auto p = (u8 const*)s.data;
+	usize n = s.len;
+	usize count = 0;
+	for(usize i = 0; i < n;){
+		usize valid = utf8_valid_prefix(p + i, n - i);
+		count += utf8_count_valid(p + i, valid, utf16);
+		i += valid;
+		if(i < n){ /* RUNE_ERROR */
+			count += 1;
+			i += 1;
 		}
-	break;
+	}
+	return count;
+}
 
-	case AllocatorMode_Free:
-		free(ptr);
-	break;
+/* Decode one sequence of valid input that is not ASCII. The length only selects between results
+ * instead of branching, which mispredicts constantly on mixed text. Needs 4 readable bytes. */
+static inline
+rune utf8_decode_valid(u8 const* p, usize* size){
+	u32 b0 = p[0];
+	usize len = 2 + usize(b0 >= 0xe0) + usize(b0 >= 0xf0);
+	rune r2 = (rune(b0 & (0x7f >> len)) << 6) | rune(p[1] & MASKX);
+	rune r3 = (r2 << 6) | rune(p[2] & MASKX);
+	rune r4 = (r3 << 6) | rune(p[3] & MASKX);
+	*size = len;
+	return len == 2 ? r2 : (len == 3 ? r3 : r4);
+}
 
-	case AllocatorMode_FreeAll:
-		/* Unsupported */
-	break;
+/* Same as utf8_decode_valid without reading past the sequence */
+static
+rune utf8_decode_valid_tail(u8 const* p, usize n, usize* size){
+	u8 tmp[4] = {};
+	mem_copy_no_overlap(tmp, p, min<usize>(n, 4));
+	return utf8_decode_valid(tmp, size);
+}
 
-	default: panic("Invalid mode");
+/* ASCII runs are widened 16 bytes at a time. The whole block is stored even when it ends in a
+ * multi byte sequence, as long as `out` has room, and the position only advances over the ASCII
+ * prefix. */
+static
+usize utf8_decode_valid_utf32(u8 const* p, usize n, rune* out, usize out_cap){
+	usize o = 0;
+	for(usize i = 0; i < n;){
+		if(p[i] < 0x80){
+#if defined(__SSE2__)
+			if(i + 16 <= n && o + 16 <= out_cap){
+				__m128i x = _mm_loadu_si128((__m128i const*)(p + i));
+				__m128i zero = _mm_setzero_si128();
+				__m128i lo = _mm_unpacklo_epi8(x, zero);
+				__m128i hi = _mm_unpackhi_epi8(x, zero);
+				_mm_storeu_si128((__m128i*)(out + o), _mm_unpacklo_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*)(out + o + 4), _mm_unpackhi_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*)(out + o + 8), _mm_unpacklo_epi16(hi, zero));
+				_mm_storeu_si128((__m128i*)(out + o + 12), _mm_unpackhi_epi16(hi, zero));
+				u32 mask = u32(_mm_movemask_epi8(x));
+				usize ascii = mask ? usize(__builtin_ctz(mask)) : 16;
+				i += ascii;
+				o += ascii;
+				continue;
+			}
+#endif
+			out[o] = rune(p[i]);
+			i += 1;
+			o += 1;
+			continue;
+		}
+		usize size = 0;
+		out[o] = i + 4 <= n ? utf8_decode_valid(p + i, &size) : utf8_decode_valid_tail(p + i, n - i, &size);
+		i += size;
+		o += 1;
 	}
+	return o;
+}
 
-	return result;
+static
+usize utf8_decode_valid_utf16(u8 const* p, usize n, u16* out, usize out_cap){
+	usize o = 0;
+	for(usize i = 0; i < n;){
+		if(p[i] < 0x80){
+#if defined(__SSE2__)
+			if(i + 16 <= n && o + 16 <= out_cap){
+				__m128i x = _mm_loadu_si128((__m128i const*)(p + i));
+				__m128i zero = _mm_setzero_si128();
+				_mm_storeu_si128((__m128i*)(out + o), _mm_unpacklo_epi8(x, zero));
+				_mm_storeu_si128((__m128i*)(out + o + 8), _mm_unpackhi_epi8(x, zero));
+				u32 mask = u32(_mm_movemask_epi8(x));
+				usize ascii = mask ? usize(__builtin_ctz(mask)) : 16;
+				i += ascii;
+				o += ascii;
+				continue;
+			}
+#endif
+			out[o] = u16(p[i]);
+			i += 1;
+			o += 1;
+			continue;
+		}
+		usize size = 0;
+		rune r = i + 4 <= n ? utf8_decode_valid(p + i, &size) : utf8_decode_valid_tail(p + i, n - i, &size);
+		i += size;
+		if(o + 2 <= out_cap){
+			/* Both units are written, the second one only counts for a pair */
+			bool pair = r >= 0x10000;
+			u32 v = u32(r) - 0x10000;
+			out[o] = u16(pair ? 0xd800 | (v >> 10) : u32(r));
+			out[o + 1] = u16(0xdc00 | (v & 0x3ff));
+			o += 1 + usize(pair);
+		}
+		else if(r >= 0x10000){
+			r -= 0x10000;
+			out[o] = u16(0xd800 | (r >> 10));
+			out[o + 1] = u16(0xdc00 | (r & 0x3ff));
+			o += 2;
+		}
+		else {
+			out[o] = u16(r);
+			o += 1;
+		}
+	}
+	return o;
 }
 
-Allocator heap_allocator(){
-	return { heap_allocator_func, nullptr };
+bool utf8_validate(String s, usize* invalid_at){
+	usize valid = utf8_valid_prefix((u8 const*)s.data, s.len);
+	if(invalid_at){ *invalid_at = valid; }
+	return valid == s.len;
+}
+
+usize utf8_rune_count(String s){
+	return utf8_decoded_len(s, false);
+}
+
+Slice<rune> utf8_to_utf32(Allocator a, String s){
+	usize count = utf8_decoded_len(s, false);
+	auto out = make_slice_uninit<rune>(a, count);
+	if(!out.data){ return Slice<rune>{ nullptr, 0 }; }
+
+	auto p = (u8 const*)s.data;
+	usize o = 0;
+	for(usize i = 0; i < s.len;){
+		usize valid = utf8_valid_prefix(p + i, s.len - i);
+		o += utf8_decode_valid_utf32(p + i, valid, out.data + o, out.len - o);
+		i += valid;
+		if(i < s.len){
+			out.data[o] = RUNE_ERROR;
+			o += 1;
+			i += 1;
+		}
+	}
+	return out;
+}
+
+Slice<u16> utf8_to_utf16(Allocator a, String s){
+	usize count = utf8_decoded_len(s, true);
+	auto out = make_slice_uninit<u16>(a, count);
+	if(!out.data){ return Slice<u16>{ nullptr, 0 }; }
+
+	auto p = (u8 const*)s.data;
+	usize o = 0;
+	for(usize i = 0; i < s.len;){
+		usize valid = utf8_valid_prefix(p + i, s.len - i);
+		o += utf8_decode_valid_utf16(p + i, valid, out.data + o, out.len - o);
+		i += valid;
+		if(i < s.len){
+			out.data[o] = u16(RUNE_ERROR);
+			o += 1;
+			i += 1;
+		}
+	}
+	return out;
+}
+
+/* Same cases as rune_encode */
+static inline
+usize rune_encoded_size(rune r){
+	if(r <= 0x7f){ return 1; }
+	if(r <= 0x7ff){ return 2; }
+	if(r > 0x10ffff || (0xd800 <= r && r <= 0xdfff) || r <= 0xffff){ return 3; }
+	return 4;
+}
+
+String utf32_to_utf8(Allocator a, Slice<rune> runes){
+	usize size = 0;
+	for(usize i = 0; i < runes.len; i += 1){
+		size += rune_encoded_size(runes.data[i]);
+	}
+	auto out = make_slice_uninit<u8>(a, size);
+	if(!out.data){ return String(); }
+
+	usize o = 0;
+	usize i = 0;
+	while(i < runes.len){
+#if defined(__SSE2__)
+		/* 16 ASCII runes narrow to 16 bytes, negative runes fail the check like any other */
+		if(i + 16 <= runes.len){
+			auto src = (__m128i const*)(runes.data + i);
+			__m128i r0 = _mm_loadu_si128(src);
+			__m128i r1 = _mm_loadu_si128(src + 1);
+			__m128i r2 = _mm_loadu_si128(src + 2);
+			__m128i r3 = _mm_loadu_si128(src + 3);
+			__m128i all = _mm_or_si128(_mm_or_si128(r0, r1), _mm_or_si128(r2, r3));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, _mm_set1_epi32(~0x7f)), _mm_setzero_si128())) == 0xffff){
+				__m128i bytes = _mm_packus_epi16(_mm_packs_epi32(r0, r1), _mm_packs_epi32(r2, r3));
+				_mm_storeu_si128((__m128i*)(out.data + o), bytes);
+				i += 16;
+				o += 16;
+				continue;
+			}
+		}
+#endif
+		RuneEncoded e = rune_encode(runes.data[i]);
+		mem_copy_no_overlap(out.data + o, e.bytes, e.size);
+		o += e.size;
+		i += 1;
+	}
+	return String(out);
+}
+
+String utf16_to_utf8(Allocator a, Slice<u16> units){
+	usize size = 0;
+	for(usize i = 0; i < units.len; i += 1){
+		u16 u = units.data[i];
+		if(u < 0x80){ size += 1; }
+		else if(u < 0x800){ size += 2; }
+		else if(u >= 0xd800 && u <= 0xdbff && i + 1 < units.len && units.data[i + 1] >= 0xdc00 && units.data[i + 1] <= 0xdfff){
+			size += 4;
+			i += 1;
+		}
+		else { size += 3; }
+	}
+	auto out = make_slice_uninit<u8>(a, size);
+	if(!out.data){ return String(); }
+
+	usize o = 0;
+	usize i = 0;
+	while(i < units.len){
+#if defined(__SSE2__)
+		if(i + 16 <= units.len){
+			auto src = (__m128i const*)(units.data + i);
+			__m128i u0 = _mm_loadu_si128(src);
+			__m128i u1 = _mm_loadu_si128(src + 1);
+			__m128i high = _mm_and_si128(_mm_or_si128(u0, u1), _mm_set1_epi16(~0x7f));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xffff){
+				_mm_storeu_si128((__m128i*)(out.data + o), _mm_packus_epi16(u0, u1));
+				i += 16;
+				o += 16;
+				continue;
+			}
+		}
+#endif
+		rune r = units.data[i];
+		i += 1;
+		if(r >= 0xd800 && r <= 0xdbff && i < units.len && units.data[i] >= 0xdc00 && units.data[i] <= 0xdfff){
+			r = 0x10000 + ((r - 0xd800) << 10) + (units.data[i] - 0xdc00);
+			i += 1;
+		}
+		RuneEncoded e = rune_encode(r);
+		mem_copy_no_overlap(out.data + o, e.bytes, e.size);
+		o += e.size;
+	}
+	return String(out);
+}
+
+//// String builder
+/* A failed reservation leaves an empty builder that keeps its allocator and retries on append */
+StringBuilder builder_create(usize cap, Allocator alloc){
+	StringBuilder sb = { make_list<u8>(alloc) };
+	reserve(&sb.buf, cap);
+	return sb;
+}
+
+void builder_destroy(StringBuilder* sb){
+	destroy(&sb->buf);
+}
+
+bool builder_append(StringBuilder* sb, String str){
+	return extend(&sb->buf, Slice<u8>{ (u8*)str.data, str.len });
+}
+
+bool builder_append_byte(StringBuilder* sb, u8 b){
+	return append(&sb->buf, b);
+}
+
+struct BuilderPrintf {
+	StringBuilder* sb;
+	bool           failed;
+};
+
+/* stb hands over every STB_SPRINTF_MIN bytes it wrote at the end of the buffer, commit them and
+ * make room for the next batch */
+static
+char* builder_printf_callback(char const* buf, void* user, int len){
+	(void)buf;
+	auto ctx = (BuilderPrintf*)user;
+	List<u8>* list = &ctx->sb->buf;
+	list->len += usize(len);
+	if(!list_grow(list, list->len + STB_SPRINTF_MIN)){
+		ctx->failed = true;
+		return nullptr;
+	}
+	return (char*)&list->data[list->len];
+}
+
+bool builder_vprintf(StringBuilder* sb, char const* fmt, va_list args){
+	usize start = sb->buf.len;
+	if(!list_grow(&sb->buf, start + STB_SPRINTF_MIN)){
+		return false;
+	}
+
+	BuilderPrintf ctx = { sb, false };
+	stbsp_vsprintfcb(builder_printf_callback, &ctx, (char*)&sb->buf.data[start], fmt, args);
+	if(ctx.failed){
+		sb->buf.len = start; /* Drop the partial output */
+		return false;
+	}
+	return true;
+}
+
+bool builder_printf(StringBuilder* sb, char const* fmt, ...){
+	va_list args;
+	va_start(args, fmt);
+	bool ok = builder_vprintf(sb, fmt, args);
+	va_end(args);
+	return ok;
+}
+
+void builder_reset(StringBuilder* sb){
+	sb->buf.len = 0;
+}
+
+String builder_string(StringBuilder const& sb){
+	return String((char const*)sb.buf.data, sb.buf.len);
+}
+
+Slice<u8> builder_bytes(StringBuilder const& sb){
+	return slice(sb.buf);
+}
+
+//// Formatting
+/* Longest output of the fast paths: sign, 20 digits, point and 15 decimals */
+constexpr usize FORMAT_MAX_LEN = 40;
+constexpr u32 FORMAT_MAX_PRECISION = 15;
+
+static const char format_decimal_pairs[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+static const char format_hex_digits[] = "0123456789abcdef";
+
+static const u64 format_pow10[FORMAT_MAX_PRECISION + 1] = {
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+	1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+	100000000000000ull, 1000000000000000ull,
+};
+
+static inline
+u32 format_decimal_len(u64 v){
+	u32 len = 1;
+	for(;;){
+		if(v < 10){ return len; }
+		if(v < 100){ return len + 1; }
+		if(v < 1000){ return len + 2; }
+		if(v < 10000){ return len + 3; }
+		v /= 10000;
+		len += 4;
+	}
+}
+
+/* Digits are produced two at a time from the end, with at least `min_digits` zero padded digits */
+static
+usize format_decimal(char* buf, u64 v, u32 min_digits = 1){
+	u32 len = max(format_decimal_len(v), min_digits);
+	char* p = buf + len;
+	while(v >= 100){
+		u64 q = v / 100;
+		p -= 2;
+		mem_copy_no_overlap(p, &format_decimal_pairs[(v - q * 100) * 2], 2);
+		v = q;
+	}
+	if(v >= 10){
+		p -= 2;
+		mem_copy_no_overlap(p, &format_decimal_pairs[v * 2], 2);
+	}
+	else {
+		p -= 1;
+		*p = char('0' + v);
+	}
+	while(p > buf){
+		p -= 1;
+		*p = '0';
+	}
+	return len;
+}
+
+static
+usize format_signed(char* buf, i64 v){
+	if(v >= 0){ return format_decimal(buf, u64(v)); }
+	buf[0] = '-';
+	return 1 + format_decimal(buf + 1, 0 - u64(v));
+}
+
+static
+usize format_hex(char* buf, u64 v, u32 min_digits){
+	u32 len = (64 - u32(__builtin_clzll(v | 1)) + 3) / 4;
+	len = max(len, min(min_digits, 16u));
+	for(u32 i = len; i > 0; i -= 1){
+		buf[i - 1] = format_hex_digits[v & 0xf];
+		v >>= 4;
+	}
+	return len;
+}
+
+/* Fixed point through one scaled integer, returns 0 when the value needs the printf path.
+ * Rounding the product to an integer is only wrong when the product landed on a tie, the exact
+ * residual from an fma then tells a real tie from a rounded one. Real ties go away from zero like
+ * stb_sprintf, so both paths agree. */
+static
+usize format_fixed(char* buf, f64 v, u32 precision){
+	if(precision > FORMAT_MAX_PRECISION || v != v){ return 0; }
+	f64 magnitude = __builtin_fabs(v);
+	f64 scale = f64(format_pow10[precision]);
+	f64 product = magnitude * scale;
+	f64 scaled = __builtin_nearbyint(product);
+	if(!(scaled < 9007199254740992.0)){ return 0; } /* 2^53, also rejects infinity */
+
+	/* From 2^52 on the product is a whole number, a tie can only be seen in the residual */
+	f64 frac = product - scaled;
+	if(frac == 0.5 || frac == -0.5 || (frac == 0 && product >= 4503599627370496.0)){
+		f64 residual = __builtin_fma(magnitude, scale, -product);
+		if(frac != 0){ scaled = residual >= 0 ? product + 0.5 : product - 0.5; }
+		else if(residual == 0.5){ scaled += 1; }
+	}
+
+	usize n = 0;
+	if(__builtin_signbit(v)){
+		buf[n] = '-';
+		n += 1;
+	}
+	u64 units = u64(scaled);
+	u64 whole = units / format_pow10[precision];
+	n += format_decimal(buf + n, whole);
+	if(precision > 0){
+		buf[n] = '.';
+		n += 1;
+		n += format_decimal(buf + n, units - whole * format_pow10[precision], precision);
+	}
+	return n;
+}
+
+/* Reserve the worst case at the end of the builder and commit what was written */
+static inline
+char* builder_format_begin(StringBuilder* sb){
+	if(!list_grow(&sb->buf, sb->buf.len + FORMAT_MAX_LEN)){ return nullptr; }
+	return (char*)&sb->buf.data[sb->buf.len];
+}
+
+bool builder_append_u64(StringBuilder* sb, u64 v){
+	char* buf = builder_format_begin(sb);
+	if(!buf){ return false; }
+	sb->buf.len += format_decimal(buf, v);
+	return true;
+}
+
+bool builder_append_i64(StringBuilder* sb, i64 v){
+	char* buf = builder_format_begin(sb);
+	if(!buf){ return false; }
+	sb->buf.len += format_signed(buf, v);
+	return true;
+}
+
+bool builder_append_hex(StringBuilder* sb, u64 v, u32 min_digits){
+	char* buf = builder_format_begin(sb);
+	if(!buf){ return false; }
+	sb->buf.len += format_hex(buf, v, min_digits);
+	return true;
+}
+
+bool builder_append_f64(StringBuilder* sb, f64 v, u32 precision){
+	char* buf = builder_format_begin(sb);
+	if(!buf){ return false; }
+	usize n = format_fixed(buf, v, precision);
+	if(n == 0){
+		return builder_printf(sb, "%.*f", int(precision), v);
+	}
+	sb->buf.len += n;
+	return true;
+}
+
+/* Allocate the worst case and give back what was not written, the block is the arena's last
+ * allocation so shrinking it always succeeds */
+static inline
+char* arena_format_begin(Arena* arena){
+	return (char*)arena_alloc_uninit(arena, FORMAT_MAX_LEN, 1);
+}
+
+static inline
+String arena_format_end(Arena* arena, char* buf, usize n){
+	arena_resize(arena, buf, n);
+	return String(buf, n);
+}
+
+String arena_format_u64(Arena* arena, u64 v){
+	char* buf = arena_format_begin(arena);
+	if(!buf){ return String(); }
+	return arena_format_end(arena, buf, format_decimal(buf, v));
+}
+
+String arena_format_i64(Arena* arena, i64 v){
+	char* buf = arena_format_begin(arena);
+	if(!buf){ return String(); }
+	return arena_format_end(arena, buf, format_signed(buf, v));
+}
+
+String arena_format_hex(Arena* arena, u64 v, u32 min_digits){
+	char* buf = arena_format_begin(arena);
+	if(!buf){ return String(); }
+	return arena_format_end(arena, buf, format_hex(buf, v, min_digits));
+}
+
+String arena_format_f64(Arena* arena, f64 v, u32 precision){
+	char* buf = arena_format_begin(arena);
+	if(!buf){ return String(); }
+	usize n = format_fixed(buf, v, precision);
+	if(n == 0){
+		arena_resize(arena, buf, 0);
+		return arena_printf(arena, "%.*f", int(precision), v);
+	}
+	return arena_format_end(arena, buf, n);
+}
+
+extern "C"{
+	void* malloc(size_t);
+	void* realloc(void*, size_t);
+	void free(void*);
+}
+
+//// Heap
+/* malloc only guarantees max_align_t, larger alignments over-allocate and keep the pointer
+ * returned by malloc right before the aligned block */
+static
+void* heap_aligned_alloc(usize size, usize align){
+	if(align <= alignof(max_align_t)){
+		return malloc(size);
+	}
+	void* raw = malloc(size + align + sizeof(void*));
+	if(!raw){ return nullptr; }
+	uintptr aligned = mem_align_forward_ptr(uintptr(raw) + sizeof(void*), align);
+	((void**)aligned)[-1] = raw;
+	return (void*)aligned;
+}
+
+static
+void heap_aligned_free(void* ptr, usize align){
+	if(!ptr){ return; }
+	if(align <= alignof(max_align_t)){
+		free(ptr);
+		return;
+	}
+	free(((void**)ptr)[-1]);
+}
+
+static
+void* heap_allocator_func(void*, AllocatorMode mode, void* ptr, usize old_size, usize new_size, usize align){
+	void* result = nullptr;
+
+	switch(mode){
+	case AllocatorMode_Alloc:
+		result = heap_aligned_alloc(new_size, align);
+		if(result){
+			mem_zero(result, new_size);
+		}
+	break;
+
+	case AllocatorMode_AllocUninit:
+		result = heap_aligned_alloc(new_size, align);
+	break;
+
+	case AllocatorMode_Realloc:
+	case AllocatorMode_ReallocUninit:
+		if(align > alignof(max_align_t)){
+			/* realloc() would lose the alignment, move the block by hand */
+			result = heap_aligned_alloc(new_size, align);
+			if(!result){ return nullptr; }
+			mem_copy_no_overlap(result, ptr, min(old_size, new_size));
+			heap_aligned_free(ptr, align);
+		}
+		else {
+			result = realloc(ptr, new_size);
+		}
+
+		if(result && (new_size > old_size) && mode == AllocatorMode_Realloc){
+			uintptr diff = new_size - old_size;
+			void* to_zero = (void*)(uintptr(result) + old_size);
+			mem_zero(to_zero, diff);
+		}
+	break;
+
+	case AllocatorMode_Free:
+		heap_aligned_free(ptr, align);
+	break;
+
+	case AllocatorMode_FreeAll:
+		/* Unsupported */
+	break;
+
+	default: panic("Invalid mode");
+	}
+
+	return result;
+}
+
+Allocator heap_allocator(){
+	return { heap_allocator_func, nullptr };
+}
+
+//// Pool
+constexpr usize POOL_CACHE_BATCH = 32;
+constexpr usize POOL_CACHE_MAX = 2 * POOL_CACHE_BATCH;
+
+Pool pool_create(usize block_size, usize block_align, usize blocks_per_chunk, Allocator backing){
+	ensure(mem_valid_alignment(block_align), "Alignment must be a power of 2 greater than 0");
+	Pool p = {};
+	block_align = max(block_align, alignof(PoolBlock));
+	p.block_size = mem_align_forward_ptr(max(block_size, sizeof(PoolBlock)), block_align);
+	p.block_align = block_align;
+	p.blocks_per_chunk = max<usize>(1, blocks_per_chunk);
+	p.backing = backing;
+	return p;
+}
+
+void pool_destroy(Pool* p){
+	PoolChunk* chunk = p->chunks;
+	while(chunk){
+		PoolChunk* next = chunk->next;
+		mem_free(p->backing, chunk, chunk->size, alignof(PoolChunk));
+		chunk = next;
+	}
+	p->chunks = nullptr;
+	p->free_list = nullptr;
+}
+
+/* Must hold the lock */
+static
+bool pool_grow(Pool* p){
+	usize size = sizeof(PoolChunk) + p->block_align + p->block_size * p->blocks_per_chunk;
+	auto chunk = (PoolChunk*)mem_alloc(p->backing, size, alignof(PoolChunk));
+	if(!chunk){ return false; }
+	chunk->size = size;
+	chunk->next = p->chunks;
+	p->chunks = chunk;
+
+	uintptr base = mem_align_forward_ptr(uintptr(chunk) + sizeof(PoolChunk), p->block_align);
+	for(usize i = p->blocks_per_chunk; i > 0; i -= 1){
+		auto block = (PoolBlock*)(base + (i - 1) * p->block_size);
+		block->next = p->free_list;
+		p->free_list = block;
+	}
+	return true;
+}
+
+void* pool_alloc_uninit(Pool* p){
+	spinlock_acquire(&p->lock);
+	if(!p->free_list && !pool_grow(p)){
+		spinlock_release(&p->lock);
+		return nullptr;
+	}
+	PoolBlock* block = p->free_list;
+	p->free_list = block->next;
+	spinlock_release(&p->lock);
+
+	return block;
+}
+
+void* pool_alloc(Pool* p){
+	void* block = pool_alloc_uninit(p);
+	if(block){
+		mem_zero(block, p->block_size);
+	}
+	return block;
+}
+
+void pool_free(Pool* p, void* ptr){
+	if(!ptr){ return; }
+	auto block = (PoolBlock*)ptr;
+	spinlock_acquire(&p->lock);
+	block->next = p->free_list;
+	p->free_list = block;
+	spinlock_release(&p->lock);
+}
+
+static
+void* pool_allocator_func(void* data, AllocatorMode mode, void* ptr, usize old_size, usize new_size, usize align){
+	auto pool = (Pool*)data;
+	(void)old_size;
+
+	switch(mode){
+	case AllocatorMode_Alloc:
+		if(new_size > pool->block_size || align > pool->block_align){ return nullptr; }
+		return pool_alloc(pool);
+
+	case AllocatorMode_AllocUninit:
+		if(new_size > pool->block_size || align > pool->block_align){ return nullptr; }
+		return pool_alloc_uninit(pool);
+
+	case AllocatorMode_Realloc:
+	case AllocatorMode_ReallocUninit:
+		if(new_size > pool->block_size || align > pool->block_align){ return nullptr; }
+		if(new_size > old_size && mode == AllocatorMode_Realloc){
+			mem_zero((void*)(uintptr(ptr) + old_size), new_size - old_size);
+		}
+		return ptr;
+
+	case AllocatorMode_Free:
+		pool_free(pool, ptr);
+	break;
+
+	case AllocatorMode_FreeAll:
+		pool_destroy(pool);
+	break;
+
+	default: panic("Invalid mode");
+	}
+
+	return nullptr;
+}
+
+Allocator pool_allocator(Pool* p){
+	return Allocator{ pool_allocator_func, p };
+}
+
+PoolCache pool_cache_create(Pool* p){
+	return PoolCache{ p, nullptr, 0 };
+}
+
+void* pool_cache_alloc_uninit(PoolCache* c){
+	if(!c->free_list){
+		Pool* p = c->pool;
+		spinlock_acquire(&p->lock);
+		for(usize i = 0; i < POOL_CACHE_BATCH; i += 1){
+			if(!p->free_list && !pool_grow(p)){ break; }
+			PoolBlock* block = p->free_list;
+			p->free_list = block->next;
+			block->next = c->free_list;
+			c->free_list = block;
+			c->count += 1;
+		}
+		spinlock_release(&p->lock);
+
+		if(!c->free_list){ return nullptr; }
+	}
+
+	PoolBlock* block = c->free_list;
+	c->free_list = block->next;
+	c->count -= 1;
+	return block;
+}
+
+void* pool_cache_alloc(PoolCache* c){
+	void* block = pool_cache_alloc_uninit(c);
+	if(block){
+		mem_zero(block, c->pool->block_size);
+	}
+	return block;
+}
+
+/* Give `count` blocks from the front of the cache back to the pool */
+static
+void pool_cache_release(PoolCache* c, usize count){
+	if(count == 0){ return; }
+
+	PoolBlock* first = c->free_list;
+	PoolBlock* last = first;
+	for(usize i = 1; i < count; i += 1){
+		last = last->next;
+	}
+	c->free_list = last->next;
+	c->count -= count;
+
+	Pool* p = c->pool;
+	spinlock_acquire(&p->lock);
+	last->next = p->free_list;
+	p->free_list = first;
+	spinlock_release(&p->lock);
+}
+
+void pool_cache_free(PoolCache* c, void* ptr){
+	if(!ptr){ return; }
+	auto block = (PoolBlock*)ptr;
+	block->next = c->free_list;
+	c->free_list = block;
+	c->count += 1;
+
+	if(c->count > POOL_CACHE_MAX){
+		pool_cache_release(c, c->count - POOL_CACHE_BATCH);
+	}
+}
+
+void pool_cache_flush(PoolCache* c){
+	pool_cache_release(c, c->count);
+}
+
+static
+void* pool_cache_allocator_func(void* data, AllocatorMode mode, void* ptr, usize old_size, usize new_size, usize align){
+	auto cache = (PoolCache*)data;
+	Pool* pool = cache->pool;
+
+	switch(mode){
+	case AllocatorMode_Alloc:
+		if(new_size > pool->block_size || align > pool->block_align){ return nullptr; }
+		return pool_cache_alloc(cache);
+
+	case AllocatorMode_AllocUninit:
+		if(new_size > pool->block_size || align > pool->block_align){ return nullptr; }
+		return pool_cache_alloc_uninit(cache);
+
+	case AllocatorMode_Realloc:
+	case AllocatorMode_ReallocUninit:
+		if(new_size > pool->block_size || align > pool->block_align){ return nullptr; }
+		if(new_size > old_size && mode == AllocatorMode_Realloc){
+			mem_zero((void*)(uintptr(ptr) + old_size), new_size - old_size);
+		}
+		return ptr;
+
+	case AllocatorMode_Free:
+		pool_cache_free(cache, ptr);
+	break;
+
+	case AllocatorMode_FreeAll:
+		/* Blocks are owned by the pool, give them back so pool_destroy can run later */
+		pool_cache_flush(cache);
+	break;
+
+	default: panic("Invalid mode");
+	}
+
+	return nullptr;
+}
+
+Allocator pool_cache_allocator(PoolCache* c){
+	return Allocator{ pool_cache_allocator_func, c };
+}
+
+//// Cached heap
+constexpr usize CACHED_HEAP_MIN_CLASS_SHIFT = 4;  /* 16 bytes */
+constexpr usize CACHED_HEAP_MAX_CLASS_SHIFT = 15; /* 32 KiB */
+constexpr usize CACHED_HEAP_CLASS_COUNT = CACHED_HEAP_MAX_CLASS_SHIFT - CACHED_HEAP_MIN_CLASS_SHIFT + 1;
+constexpr usize CACHED_HEAP_CHUNK_SIZE = 256 * 1024;
+
+static Pool cached_heap_pools[CACHED_HEAP_CLASS_COUNT];
+static i32 cached_heap_state = 0; /* 0: uninitialized, 1: initializing, 2: ready */
+
+static thread_local PoolCache cached_heap_caches[CACHED_HEAP_CLASS_COUNT];
+
+static
+void cached_heap_init(){
+	if(atomic_load(&cached_heap_state, MemoryOrder_Acquire) == 2){ return; }
+
+	i32 expected = 0;
+	if(atomic_cas(&cached_heap_state, &expected, 1)){
+		for(usize i = 0; i < CACHED_HEAP_CLASS_COUNT; i += 1){
+			usize size = usize(1) << (i + CACHED_HEAP_MIN_CLASS_SHIFT);
+			/* Blocks are aligned to their own size, so any alignment up to the class size is honored */
+			cached_heap_pools[i] = pool_create(size, size, max<usize>(8, CACHED_HEAP_CHUNK_SIZE / size), heap_allocator());
+		}
+		atomic_store(&cached_heap_state, 2, MemoryOrder_Release);
+		return;
+	}
+
+	while(atomic_load(&cached_heap_state, MemoryOrder_Acquire) != 2){
+		cpu_relax();
+	}
+}
+
+/* Index of the smallest class fitting both size and alignment, CACHED_HEAP_CLASS_COUNT if too large */
+static inline
+usize cached_heap_class(usize size, usize align){
+	usize n = max(size, align);
+	if(n <= (usize(1) << CACHED_HEAP_MIN_CLASS_SHIFT)){ return 0; }
+	usize shift = usize(64 - __builtin_clzll(u64(n - 1)));
+	return min(shift - CACHED_HEAP_MIN_CLASS_SHIFT, CACHED_HEAP_CLASS_COUNT);
+}
+
+static inline
+PoolCache* cached_heap_cache(usize cls){
+	PoolCache* cache = &cached_heap_caches[cls];
+	if(!cache->pool){
+		cached_heap_init();
+		*cache = pool_cache_create(&cached_heap_pools[cls]);
+	}
+	return cache;
+}
+
+static
+void* cached_heap_allocator_func(void*, AllocatorMode mode, void* ptr, usize old_size, usize new_size, usize align){
+	switch(mode){
+	case AllocatorMode_Alloc:
+	case AllocatorMode_AllocUninit: {
+		if(new_size == 0){ return nullptr; }
+		usize cls = cached_heap_class(new_size, align);
+		if(cls == CACHED_HEAP_CLASS_COUNT){
+			return heap_allocator().func(nullptr, mode, nullptr, 0, new_size, align);
+		}
+		/* Only the requested bytes are cleared, growing in place clears the rest on demand */
+		void* block = pool_cache_alloc_uninit(cached_heap_cache(cls));
+		if(block && mode == AllocatorMode_Alloc){
+			mem_zero(block, new_size);
+		}
+		return block;
+	}
+
+	case AllocatorMode_Realloc:
+	case AllocatorMode_ReallocUninit: {
+		bool zero = mode == AllocatorMode_Realloc;
+		usize old_cls = cached_heap_class(old_size, align);
+		usize new_cls = cached_heap_class(new_size, align);
+		if(old_cls == CACHED_HEAP_CLASS_COUNT && new_cls == CACHED_HEAP_CLASS_COUNT){
+			return heap_allocator().func(nullptr, mode, ptr, old_size, new_size, align);
+		}
+		if(old_cls == new_cls){
+			if(zero && new_size > old_size){
+				mem_zero((void*)(uintptr(ptr) + old_size), new_size - old_size);
+			}
+			return ptr;
+		}
+
+		void* result = cached_heap_allocator_func(nullptr, AllocatorMode_AllocUninit, nullptr, 0, new_size, align);
+		if(!result){ return nullptr; }
+		mem_copy_no_overlap(result, ptr, min(old_size, new_size));
+		if(zero && new_size > old_size){
+			mem_zero((void*)(uintptr(result) + old_size), new_size - old_size);
+		}
+		cached_heap_allocator_func(nullptr, AllocatorMode_Free, ptr, old_size, 0, align);
+		return result;
+	}
+
+	case AllocatorMode_Free: {
+		if(!ptr){ return nullptr; }
+		usize cls = cached_heap_class(old_size, align);
+		if(cls == CACHED_HEAP_CLASS_COUNT){
+			mem_free(heap_allocator(), ptr, old_size, align);
+		}
+		else {
+			pool_cache_free(cached_heap_cache(cls), ptr);
+		}
+	} break;
+
+	case AllocatorMode_FreeAll:
+		/* Unsupported */
+	break;
+
+	default: panic("Invalid mode");
+	}
+
+	return nullptr;
+}
+
+Allocator cached_heap_allocator(){
+	return { cached_heap_allocator_func, nullptr };
+}
+
+void cached_heap_thread_flush(){
+	for(usize i = 0; i < CACHED_HEAP_CLASS_COUNT; i += 1){
+		if(cached_heap_caches[i].pool){
+			pool_cache_flush(&cached_heap_caches[i]);
+		}
+	}
+}
+
+//// Tracking allocator
+static inline
+usize tracking_histogram_bucket(usize size){
+	if(size == 0){ return 0; }
+	usize bucket = usize(63 - __builtin_clzll(u64(size)));
+	return min(bucket, ALLOCATION_HISTOGRAM_BUCKETS - 1);
+}
+
+static
+void tracking_add_live(AllocationStats* s, i64 delta){
+	i64 live = atomic_add(&s->live_bytes, delta, MemoryOrder_Relaxed) + delta;
+	i64 peak = atomic_load(&s->peak_bytes, MemoryOrder_Relaxed);
+	while(live > peak){
+		if(atomic_cas(&s->peak_bytes, &peak, live, MemoryOrder_Relaxed, MemoryOrder_Relaxed)){ break; }
+	}
+}
+
+static
+void tracking_record(AllocationStats* s, AllocatorMode mode, void* ptr, void* result, usize old_size, usize new_size){
+	switch(mode){
+	case AllocatorMode_Alloc:
+		if(!result){
+			atomic_add(&s->failed_count, u64(1), MemoryOrder_Relaxed);
+			break;
+		}
+		/* alloc_count is the sum of the histogram and bytes_freed follows from the live bytes */
+		atomic_add(&s->bytes_allocated, u64(new_size), MemoryOrder_Relaxed);
+		atomic_add(&s->size_histogram[tracking_histogram_bucket(new_size)], u64(1), MemoryOrder_Relaxed);
+		tracking_add_live(s, i64(new_size));
+	break;
+
+	case AllocatorMode_Realloc:
+		if(!result){
+			if(new_size > 0){ atomic_add(&s->failed_count, u64(1), MemoryOrder_Relaxed); }
+			break;
+		}
+		if(result != ptr){
+			atomic_add(&s->realloc_move_count, u64(1), MemoryOrder_Relaxed);
+		}
+		if(new_size > old_size){
+			atomic_add(&s->realloc_grow_count, u64(1), MemoryOrder_Relaxed);
+			atomic_add(&s->bytes_allocated, u64(new_size - old_size), MemoryOrder_Relaxed);
+		}
+		else {
+			atomic_add(&s->realloc_shrink_count, u64(1), MemoryOrder_Relaxed);
+		}
+		tracking_add_live(s, i64(new_size) - i64(old_size));
+	break;
+
+	case AllocatorMode_Free:
+		atomic_add(&s->free_count, u64(1), MemoryOrder_Relaxed);
+		tracking_add_live(s, -i64(old_size));
+	break;
+
+	default:
+		/* FreeAll does not report sizes, the counters are left alone */
+	break;
+	}
+}
+
+static
+void* tracking_allocator_func(void* data, AllocatorMode mode, void* ptr, usize old_size, usize new_size, usize align){
+	auto site = (AllocationSite*)data;
+	AllocationTracker* t = site->tracker;
+
+	void* result = t->inner.func(t->inner.data, mode, ptr, old_size, new_size, align);
+	if(mode == AllocatorMode_AllocUninit){ mode = AllocatorMode_Alloc; }
+	if(mode == AllocatorMode_ReallocUninit){ mode = AllocatorMode_Realloc; }
+	tracking_record(&site->stats, mode, ptr, result, old_size, new_size);
+
+	/* Other totals are summed from the sites, only the peak has to be tracked globally */
+	if(result || mode == AllocatorMode_Free){
+		switch(mode){
+		case AllocatorMode_Alloc:   tracking_add_live(&t->total, i64(new_size)); break;
+		case AllocatorMode_Realloc: tracking_add_live(&t->total, i64(new_size) - i64(old_size)); break;
+		case AllocatorMode_Free:    tracking_add_live(&t->total, -i64(old_size)); break;
+		default: break;
+		}
+	}
+	return result;
+}
+
+AllocationTracker allocation_tracker_create(Allocator inner){
+	AllocationTracker t = {};
+	t.inner = inner;
+	return t;
+}
+
+void allocation_tracker_destroy(AllocationTracker* t){
+	spinlock_acquire(&t->lock);
+	AllocationSite* site = t->sites;
+	while(site){
+		AllocationSite* next = site->next;
+		mem_free(t->inner, site, sizeof(AllocationSite), alignof(AllocationSite));
+		site = next;
+	}
+	t->sites = nullptr;
+	spinlock_release(&t->lock);
+}
+
+Allocator tracking_allocator_ex(AllocationTracker* t, cstring file, i32 line){
+	spinlock_acquire(&t->lock);
+	AllocationSite* site = t->sites;
+	for(; site; site = site->next){
+		/* __FILE__ is not guaranteed to be pooled, compare the contents */
+		if(site->line == line && (site->file == file || String(site->file) == String(file))){ break; }
+	}
+
+	if(!site){
+		site = make<AllocationSite>(t->inner);
+		if(site){
+			site->file = file;
+			site->line = line;
+			site->tracker = t;
+			site->next = t->sites;
+			atomic_store(&t->sites, site, MemoryOrder_Release);
+		}
+	}
+	spinlock_release(&t->lock);
+
+	ensure(site, "Failed to allocate tracking site");
+	return { tracking_allocator_func, site };
+}
+
+static
+AllocationStats tracking_stats_load(AllocationStats const* s){
+	AllocationStats r;
+	r.alloc_count          = 0;
+	r.free_count           = atomic_load(&s->free_count, MemoryOrder_Relaxed);
+	r.failed_count         = atomic_load(&s->failed_count, MemoryOrder_Relaxed);
+	r.realloc_grow_count   = atomic_load(&s->realloc_grow_count, MemoryOrder_Relaxed);
+	r.realloc_shrink_count = atomic_load(&s->realloc_shrink_count, MemoryOrder_Relaxed);
+	r.realloc_move_count   = atomic_load(&s->realloc_move_count, MemoryOrder_Relaxed);
+	r.bytes_allocated      = atomic_load(&s->bytes_allocated, MemoryOrder_Relaxed);
+	r.live_bytes           = atomic_load(&s->live_bytes, MemoryOrder_Relaxed);
+	r.peak_bytes           = atomic_load(&s->peak_bytes, MemoryOrder_Relaxed);
+	r.bytes_freed          = r.bytes_allocated - u64(r.live_bytes);
+	for(usize i = 0; i < ALLOCATION_HISTOGRAM_BUCKETS; i += 1){
+		r.size_histogram[i] = atomic_load(&s->size_histogram[i], MemoryOrder_Relaxed);
+		r.alloc_count += r.size_histogram[i];
+	}
+	return r;
+}
+
+AllocationStats allocation_tracker_totals(AllocationTracker* t){
+	AllocationStats total = {};
+	for(AllocationSite* site = atomic_load(&t->sites, MemoryOrder_Acquire); site; site = site->next){
+		AllocationStats s = tracking_stats_load(&site->stats);
+		total.alloc_count          += s.alloc_count;
+		total.free_count           += s.free_count;
+		total.failed_count         += s.failed_count;
+		total.realloc_grow_count   += s.realloc_grow_count;
+		total.realloc_shrink_count += s.realloc_shrink_count;
+		total.realloc_move_count   += s.realloc_move_count;
+		total.bytes_allocated      += s.bytes_allocated;
+		for(usize i = 0; i < ALLOCATION_HISTOGRAM_BUCKETS; i += 1){
+			total.size_histogram[i] += s.size_histogram[i];
+		}
+	}
+	total.live_bytes  = atomic_load(&t->total.live_bytes, MemoryOrder_Relaxed);
+	total.peak_bytes  = atomic_load(&t->total.peak_bytes, MemoryOrder_Relaxed);
+	total.bytes_freed = total.bytes_allocated - u64(total.live_bytes);
+	return total;
+}
+
+usize allocation_tracker_snapshot(AllocationTracker* t, Slice<AllocationSite> out){
+	usize count = 0;
+	/* Sites are only ever prepended, so the list can be walked without the lock */
+	for(AllocationSite* site = atomic_load(&t->sites, MemoryOrder_Acquire); site; site = site->next){
+		AllocationSite copy = {};
+		copy.file = site->file;
+		copy.line = site->line;
+		copy.stats = tracking_stats_load(&site->stats);
+		copy.tracker = t;
+
+		/* Insertion sort, keeping the busiest `out.len` sites */
+		usize pos = count;
+		while(pos > 0 && out.data[pos - 1].stats.bytes_allocated < copy.stats.bytes_allocated){
+			pos -= 1;
+		}
+		if(pos >= out.len){ continue; }
+
+		usize last = min(count, out.len - 1);
+		mem_copy(&out.data[pos + 1], &out.data[pos], sizeof(AllocationSite) * (last - pos));
+		out.data[pos] = copy;
+		count = min(count + 1, out.len);
+	}
+	return count;
+}
+
+void allocation_tracker_dump(AllocationTracker* t, usize max_sites){
+	AllocationStats total = allocation_tracker_totals(t);
+	fprintf(stderr, "Allocations: %llu allocs, %llu frees, %llu failed, %llu bytes allocated, %lld live, %lld peak\n",
+		(unsigned long long)total.alloc_count, (unsigned long long)total.free_count, (unsigned long long)total.failed_count,
+		(unsigned long long)total.bytes_allocated, (long long)total.live_bytes, (long long)total.peak_bytes);
+	fprintf(stderr, "Reallocations: %llu grow, %llu shrink, %llu moved\n",
+		(unsigned long long)total.realloc_grow_count, (unsigned long long)total.realloc_shrink_count,
+		(unsigned long long)total.realloc_move_count);
+
+	fprintf(stderr, "Sizes:");
+	for(usize i = 0; i < ALLOCATION_HISTOGRAM_BUCKETS; i += 1){
+		if(total.size_histogram[i] == 0){ continue; }
+		fprintf(stderr, " [2^%zu]=%llu", i, (unsigned long long)total.size_histogram[i]);
+	}
+	fprintf(stderr, "\n");
+
+	if(max_sites == 0){ return; }
+	auto sites = make_slice<AllocationSite>(heap_allocator(), max_sites);
+	if(!sites.data){ return; }
+
+	usize count = allocation_tracker_snapshot(t, sites);
+	fprintf(stderr, "%-32s %10s %10s %14s %12s %12s %8s\n", "Site", "Allocs", "Frees", "Bytes", "Live", "Peak", "Grows");
+	for(usize i = 0; i < count; i += 1){
+		AllocationSite const& site = sites[i];
+		char location[256];
+		stbsp_snprintf(location, sizeof(location), "%s:%d", site.file, site.line);
+		fprintf(stderr, "%-32s %10llu %10llu %14llu %12lld %12lld %8llu\n", location,
+			(unsigned long long)site.stats.alloc_count, (unsigned long long)site.stats.free_count,
+			(unsigned long long)site.stats.bytes_allocated, (long long)site.stats.live_bytes,
+			(long long)site.stats.peak_bytes, (unsigned long long)site.stats.realloc_grow_count);
+	}
+
+	mem_free(heap_allocator(), sites.data, sizeof(AllocationSite) * sites.len, alignof(AllocationSite));
+}
+
+//// Interner
+constexpr usize INTERN_TABLE_MIN_CAPACITY = 64;
+
+/* Segment k holds 2^(k + INTERN_SEGMENT_SHIFT) entries, the first entry has id 1 */
+static inline
+InternEntry* interner_entry(Interner* in, u32 id){
+	usize k = usize(id - 1) + (usize(1) << INTERN_SEGMENT_SHIFT);
+	usize segment = usize(63 - __builtin_clzll(k)) - INTERN_SEGMENT_SHIFT;
+	InternEntry* entries = atomic_load(&in->segments[segment], MemoryOrder_Acquire);
+	return &entries[k - (usize(1) << (segment + INTERN_SEGMENT_SHIFT))];
+}
+
+static
+u32 interner_lookup(Interner* in, InternTable* table, String s, u64 hash){
+	usize mask = table->cap - 1;
+	for(usize i = usize(hash) & mask;; i = (i + 1) & mask){
+		u64 slot = atomic_load(&table->slots[i], MemoryOrder_Acquire);
+		if(slot == 0){ return 0; }
+		if(u32(slot >> 32) != u32(hash >> 32)){ continue; }
+
+		u32 id = u32(slot);
+		InternEntry* entry = interner_entry(in, id);
+		if(entry->hash == hash && entry->str == s){ return id; }
+	}
+}
+
+/* Slots are published with a release store after the entry they point to is complete */
+static
+void interner_table_insert(InternTable* table, u64 hash, u32 id){
+	usize mask = table->cap - 1;
+	usize i = usize(hash) & mask;
+	while(table->slots[i] != 0){
+		i = (i + 1) & mask;
+	}
+	atomic_store(&table->slots[i], (hash & ~u64(0xffffffff)) | u64(id), MemoryOrder_Release);
+}
+
+static
+InternTable* interner_table_create(Allocator a, usize cap){
+	auto table = make<InternTable>(a);
+	if(!table){ return nullptr; }
+	auto slots = make_slice<u64>(a, cap);
+	if(!slots.data){
+		mem_free(a, table, sizeof(InternTable), alignof(InternTable));
+		return nullptr;
+	}
+	table->slots = slots.data;
+	table->cap = cap;
+	return table;
+}
+
+/* Must hold the lock. The old table is retired, not freed, as readers may be probing it */
+static
+bool interner_reserve(Interner* in, u32 count){
+	InternTable* old = in->table;
+	if(old && usize(count) * 4 <= old->cap * 3){ return true; }
+
+	usize cap = old ? old->cap * 2 : INTERN_TABLE_MIN_CAPACITY;
+	InternTable* table = interner_table_create(in->backing, cap);
+	if(!table){ return false; }
+
+	for(u32 id = 1; id <= in->count; id += 1){
+		interner_table_insert(table, interner_entry(in, id)->hash, id);
+	}
+	table->prev = old;
+	atomic_store(&in->table, table, MemoryOrder_Release);
+	return true;
+}
+
+/* Must hold the lock */
+static
+char* interner_copy_string(Interner* in, String s){
+	auto p = (char*)arena_alloc_uninit(&in->strings, s.len + 1, 1);
+	if(!p){
+		usize size = max(INTERN_CHUNK_SIZE, sizeof(InternChunk) + s.len + 1);
+		auto chunk = (InternChunk*)mem_alloc_uninit(in->backing, size, alignof(InternChunk));
+		if(!chunk){ return nullptr; }
+		chunk->size = size;
+		chunk->next = in->chunks;
+		in->chunks = chunk;
+
+		in->strings = arena_from_buffer(Slice<u8>{ (u8*)(chunk + 1), size - sizeof(InternChunk) });
+		p = (char*)arena_alloc_uninit(&in->strings, s.len + 1, 1);
+	}
+	mem_copy(p, s.data, s.len);
+	p[s.len] = 0;
+	return p;
+}
+
+/* Must hold the lock */
+static
+u32 interner_insert(Interner* in, String s, u64 hash){
+	u32 id = in->count + 1;
+	usize k = usize(id - 1) + (usize(1) << INTERN_SEGMENT_SHIFT);
+	usize segment = usize(63 - __builtin_clzll(k)) - INTERN_SEGMENT_SHIFT;
+	if(segment >= INTERN_MAX_SEGMENTS){ return 0; }
+
+	if(!interner_reserve(in, id)){ return 0; }
+
+	if(!in->segments[segment]){
+		/* Entries are always written before their id is published */
+		auto entries = make_slice_uninit<InternEntry>(in->backing, usize(1) << (segment + INTERN_SEGMENT_SHIFT));
+		if(!entries.data){ return 0; }
+		atomic_store(&in->segments[segment], entries.data, MemoryOrder_Release);
+	}
+
+	char* data = interner_copy_string(in, s);
+	if(!data){ return 0; }
+
+	InternEntry* entry = interner_entry(in, id);
+	entry->str = String(data, s.len);
+	entry->hash = hash;
+	atomic_store(&in->count, id, MemoryOrder_Release);
+	interner_table_insert(in->table, hash, id);
+	return id;
+}
+
+Interner interner_create(Allocator backing){
+	Interner in = {};
+	in.backing = backing;
+	return in;
+}
+
+void interner_destroy(Interner* in){
+	InternTable* table = in->table;
+	while(table){
+		InternTable* prev = table->prev;
+		mem_free(in->backing, table->slots, sizeof(u64) * table->cap, alignof(u64));
+		mem_free(in->backing, table, sizeof(InternTable), alignof(InternTable));
+		table = prev;
+	}
+
+	for(usize i = 0; i < INTERN_MAX_SEGMENTS && in->segments[i]; i += 1){
+		usize size = sizeof(InternEntry) << (i + INTERN_SEGMENT_SHIFT);
+		mem_free(in->backing, in->segments[i], size, alignof(InternEntry));
+	}
+
+	InternChunk* chunk = in->chunks;
+	while(chunk){
+		InternChunk* next = chunk->next;
+		mem_free(in->backing, chunk, chunk->size, alignof(InternChunk));
+		chunk = next;
+	}
+
+	*in = interner_create(in->backing);
+}
+
+bool interner_find(Interner* in, String s, Symbol* sym){
+	if(s.len == 0){
+		*sym = Symbol{ 0 };
+		return true;
+	}
+	InternTable* table = atomic_load(&in->table, MemoryOrder_Acquire);
+	if(!table){ return false; }
+
+	u32 id = interner_lookup(in, table, s, hash64(s));
+	*sym = Symbol{ id };
+	return id != 0;
+}
+
+Symbol intern(Interner* in, String s){
+	if(s.len == 0){ return Symbol{ 0 }; }
+
+	u64 hash = hash64(s);
+	InternTable* table = atomic_load(&in->table, MemoryOrder_Acquire);
+	if(table){
+		u32 id = interner_lookup(in, table, s, hash);
+		if(id){ return Symbol{ id }; }
+	}
+
+	/* Another thread may have inserted it since, or the table we probed was already replaced */
+	spinlock_acquire(&in->lock);
+	u32 id = in->table ? interner_lookup(in, in->table, s, hash) : 0;
+	if(!id){
+		id = interner_insert(in, s, hash);
+	}
+	spinlock_release(&in->lock);
+	return Symbol{ id };
+}
+
+String interner_get(Interner* in, Symbol sym){
+	if(sym.id == 0){ return String(); }
+	ensure(sym.id <= atomic_load(&in->count, MemoryOrder_Relaxed), "Symbol does not belong to this interner");
+	return interner_entry(in, sym.id)->str;
+}
+
+u32 interner_count(Interner* in){
+	return atomic_load(&in->count, MemoryOrder_Acquire);
+}
+
+//// CPU
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+
+static
+u64 cpu_xgetbv(u32 index){
+	u32 lo, hi;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(index));
+	return (u64(hi) << 32) | u64(lo);
+}
+
+static
+u32 cpu_detect_features(){
+	u32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+	u32 features = 0;
+
+	if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)){ return 0; }
+	if(edx & (1u << 26)){ features |= CPUFeature_SSE2; }
+	if(ecx & (1u << 9)){  features |= CPUFeature_SSSE3; }
+	if(ecx & (1u << 19)){ features |= CPUFeature_SSE41; }
+	if(ecx & (1u << 20)){ features |= CPUFeature_SSE42; }
+	if(ecx & (1u << 1)){  features |= CPUFeature_PCLMUL; }
+
+	/* Wider registers also need the OS to save their state on context switches */
+	bool osxsave = ecx & (1u << 27);
+	u64 xcr0 = osxsave ? cpu_xgetbv(0) : 0;
+	bool os_avx = (xcr0 & 0x06) == 0x06;
+	bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+
+	if(os_avx && (ecx & (1u << 28))){ features |= CPUFeature_AVX; }
+
+	if(__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)){
+		if(os_avx && (ebx & (1u << 5))){ features |= CPUFeature_AVX2; }
+		if(os_avx512){
+			if(ebx & (1u << 16)){ features |= CPUFeature_AVX512F; }
+			if(ebx & (1u << 30)){ features |= CPUFeature_AVX512BW; }
+			if(ebx & (1u << 31)){ features |= CPUFeature_AVX512VL; }
+			if(ecx & (1u << 10)){ features |= CPUFeature_VPCLMULQDQ; }
+		}
+	}
+
+	return features;
+}
+#else
+static
+u32 cpu_detect_features(){
+	return 0;
+}
+#endif
+
+u32 cpu_features(){
+	constexpr u32 unknown = 0x80000000;
+	static u32 cached = unknown;
+
+	u32 features = atomic_load(&cached, MemoryOrder_Relaxed);
+	if(features == unknown){
+		features = cpu_detect_features();
+		atomic_store(&cached, features, MemoryOrder_Relaxed);
+	}
+	return features;
+}
+
+//// Threads & Time
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+struct ThreadStart {
+	ThreadProc proc;
+	void* arg;
+};
+
+static
+DWORD WINAPI thread_entry(LPVOID p){
+	ThreadStart start = *(ThreadStart*)p;
+	mem_free(heap_allocator(), p, sizeof(ThreadStart), alignof(ThreadStart));
+	start.proc(start.arg);
+	return 0;
+}
+
+Thread thread_create(ThreadProc proc, void* arg){
+	auto start = make<ThreadStart>(heap_allocator());
+	if(!start){ return {}; }
+	start->proc = proc;
+	start->arg = arg;
+
+	HANDLE h = CreateThread(nullptr, 0, thread_entry, start, 0, nullptr);
+	if(!h){
+		mem_free(heap_allocator(), start, sizeof(ThreadStart), alignof(ThreadStart));
+		return {};
+	}
+	return Thread{ (void*)h };
+}
+
+void thread_join(Thread t){
+	WaitForSingleObject((HANDLE)t.handle, INFINITE);
+	CloseHandle((HANDLE)t.handle);
+}
+
+void thread_yield(){
+	SwitchToThread();
+}
+
+i32 cpu_count(){
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return max<i32>(1, i32(info.dwNumberOfProcessors));
+}
+
+Semaphore semaphore_create(i32 initial){
+	HANDLE h = CreateSemaphoreA(nullptr, initial, 0x7fffffff, nullptr);
+	return Semaphore{ (void*)h };
+}
+
+void semaphore_destroy(Semaphore s){
+	CloseHandle((HANDLE)s.handle);
+}
+
+void semaphore_wait(Semaphore s){
+	WaitForSingleObject((HANDLE)s.handle, INFINITE);
+}
+
+void semaphore_post(Semaphore s, i32 n){
+	ReleaseSemaphore((HANDLE)s.handle, n, nullptr);
+}
+
+u64 time_now(){
+	LARGE_INTEGER freq, counter;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&counter);
+	u64 secs = u64(counter.QuadPart / freq.QuadPart);
+	u64 rem  = u64(counter.QuadPart % freq.QuadPart);
+	return secs * 1000000000ull + (rem * 1000000000ull) / u64(freq.QuadPart);
+}
+
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <time.h>
+
+struct ThreadStart {
+	ThreadProc proc;
+	void* arg;
+};
+
+static
+void* thread_entry(void* p){
+	ThreadStart start = *(ThreadStart*)p;
+	mem_free(heap_allocator(), p, sizeof(ThreadStart), alignof(ThreadStart));
+	start.proc(start.arg);
+	return nullptr;
+}
+
+Thread thread_create(ThreadProc proc, void* arg){
+	auto start = make<ThreadStart>(heap_allocator());
+	auto handle = make<pthread_t>(heap_allocator());
+	if(!start || !handle){
+		mem_free(heap_allocator(), start, sizeof(ThreadStart), alignof(ThreadStart));
+		mem_free(heap_allocator(), handle, sizeof(pthread_t), alignof(pthread_t));
+		return {};
+	}
+	start->proc = proc;
+	start->arg = arg;
+
+	if(pthread_create(handle, nullptr, thread_entry, start) != 0){
+		mem_free(heap_allocator(), start, sizeof(ThreadStart), alignof(ThreadStart));
+		mem_free(heap_allocator(), handle, sizeof(pthread_t), alignof(pthread_t));
+		return {};
+	}
+	return Thread{ (void*)handle };
+}
+
+void thread_join(Thread t){
+	auto handle = (pthread_t*)t.handle;
+	pthread_join(*handle, nullptr);
+	mem_free(heap_allocator(), handle, sizeof(pthread_t), alignof(pthread_t));
+}
+
+void thread_yield(){
+	sched_yield();
+}
+
+i32 cpu_count(){
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return max<i32>(1, i32(n));
+}
+
+/* POSIX unnamed semaphores are not available everywhere (macOS), so build one from a mutex and a condition variable */
+struct SemaphoreImpl {
+	pthread_mutex_t mutex;
+	pthread_cond_t  cond;
+	i32 count;
+};
+
+Semaphore semaphore_create(i32 initial){
+	auto sem = make<SemaphoreImpl>(heap_allocator());
+	if(!sem){ return {}; }
+	pthread_mutex_init(&sem->mutex, nullptr);
+	pthread_cond_init(&sem->cond, nullptr);
+	sem->count = initial;
+	return Semaphore{ (void*)sem };
+}
+
+void semaphore_destroy(Semaphore s){
+	auto sem = (SemaphoreImpl*)s.handle;
+	if(!sem){ return; }
+	pthread_cond_destroy(&sem->cond);
+	pthread_mutex_destroy(&sem->mutex);
+	mem_free(heap_allocator(), sem, sizeof(SemaphoreImpl), alignof(SemaphoreImpl));
+}
+
+void semaphore_wait(Semaphore s){
+	auto sem = (SemaphoreImpl*)s.handle;
+	pthread_mutex_lock(&sem->mutex);
+	while(sem->count <= 0){
+		pthread_cond_wait(&sem->cond, &sem->mutex);
+	}
+	sem->count -= 1;
+	pthread_mutex_unlock(&sem->mutex);
+}
+
+void semaphore_post(Semaphore s, i32 n){
+	auto sem = (SemaphoreImpl*)s.handle;
+	pthread_mutex_lock(&sem->mutex);
+	sem->count += n;
+	pthread_mutex_unlock(&sem->mutex);
+	if(n == 1){
+		pthread_cond_signal(&sem->cond);
+	} else {
+		pthread_cond_broadcast(&sem->cond);
+	}
+}
+u64 time_now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return u64(ts.tv_sec) * 1000000000ull + u64(ts.tv_nsec);
+}
+#endif
+
+//// Virtual memory
+#if defined(_WIN32)
+usize os_page_size(){
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return usize(info.dwPageSize);
+}
+
+void* os_mem_reserve(usize size){
+	return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool os_mem_commit(void* p, usize size){
+	return VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void os_mem_decommit(void* p, usize size){
+	VirtualFree(p, size, MEM_DECOMMIT);
+}
+
+void os_mem_release(void* p, usize size){
+	(void)size;
+	VirtualFree(p, 0, MEM_RELEASE);
+}
+
+bool os_mem_advise_huge_pages(void* p, usize size){
+	(void)p; (void)size;
+	return false; /* Large pages need SeLockMemoryPrivilege and cannot be committed lazily */
+}
+
+#else
+#include <sys/mman.h>
+
+usize os_page_size(){
+	return usize(sysconf(_SC_PAGESIZE));
+}
+
+void* os_mem_reserve(usize size){
+	void* p = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	return (p == MAP_FAILED) ? nullptr : p;
+}
+
+bool os_mem_commit(void* p, usize size){
+	return mprotect(p, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void os_mem_decommit(void* p, usize size){
+	madvise(p, size, MADV_DONTNEED);
+	mprotect(p, size, PROT_NONE);
+}
+
+void os_mem_release(void* p, usize size){
+	munmap(p, size);
+}
+
+bool os_mem_advise_huge_pages(void* p, usize size){
+#if defined(MADV_HUGEPAGE)
+	return madvise(p, size, MADV_HUGEPAGE) == 0;
+#else
+	(void)p; (void)size;
+	return false;
+#endif
+}
+#endif
+
+//// Files
+/* Paths are views, the OS wants them null terminated */
+static
+char* file_path_cstring(String path){
+	auto buf = make_slice_uninit<char>(heap_allocator(), path.len + 1);
+	if(!buf.data){ return nullptr; }
+	mem_copy_no_overlap(buf.data, path.data, path.len);
+	buf[path.len] = 0;
+	return buf.data;
+}
+
+static
+void file_path_free(String path, char* cpath){
+	mem_free(heap_allocator(), cpath, path.len + 1, 1);
+}
+
+#if defined(_WIN32)
+static
+HANDLE file_open_read(String path){
+	char* cpath = file_path_cstring(path);
+	if(!cpath){ return INVALID_HANDLE_VALUE; }
+	HANDLE h = CreateFileA(cpath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	file_path_free(path, cpath);
+	return h;
+}
+
+Slice<u8> file_map(String path, u32 hints){
+	(void)hints; /* The memory manager reads ahead on its own, PrefetchVirtualMemory needs Windows 8 */
+	HANDLE file = file_open_read(path);
+	if(file == INVALID_HANDLE_VALUE){ return {}; }
+
+	Slice<u8> data = {};
+	LARGE_INTEGER size;
+	if(GetFileType(file) == FILE_TYPE_DISK && GetFileSizeEx(file, &size) && size.QuadPart > 0){
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(mapping){
+			void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if(view){
+				data = Slice<u8>{ (u8*)view, usize(size.QuadPart) };
+			}
+			CloseHandle(mapping); /* The view keeps the mapping alive */
+		}
+	}
+	CloseHandle(file);
+	return data;
+}
+
+void file_unmap(Slice<u8> data){
+	if(data.data){
+		UnmapViewOfFile(data.data);
+	}
+}
+
+bool chunk_reader_open(ChunkReader* r, String path){
+	*r = ChunkReader{};
+	if(path == "-"){
+		r->handle = (void*)GetStdHandle(STD_INPUT_HANDLE);
+		return r->handle != nullptr && r->handle != INVALID_HANDLE_VALUE;
+	}
+
+	HANDLE h = file_open_read(path);
+	if(h == INVALID_HANDLE_VALUE){ return false; }
+	r->handle = (void*)h;
+	r->owned = true;
+	return true;
+}
+
+usize chunk_read(ChunkReader* r, Slice<u8> buf){
+	usize total = 0;
+	while(total < buf.len){
+		DWORD got = 0;
+		DWORD want = DWORD(min<usize>(buf.len - total, 1u << 30));
+		if(!ReadFile((HANDLE)r->handle, buf.data + total, want, &got, nullptr)){
+			/* The writing end of a pipe closing is the end of the input */
+			if(GetLastError() != ERROR_BROKEN_PIPE){
+				r->failed = true;
+			}
+			break;
+		}
+		if(got == 0){ break; }
+		total += got;
+	}
+	return total;
+}
+
+void chunk_reader_close(ChunkReader* r){
+	if(r->owned && r->handle){
+		CloseHandle((HANDLE)r->handle);
+	}
+	r->handle = nullptr;
+}
+
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+static
+int file_open_read(String path){
+	char* cpath = file_path_cstring(path);
+	if(!cpath){ return -1; }
+	int fd = open(cpath, O_RDONLY | O_CLOEXEC);
+	file_path_free(path, cpath);
+	return fd;
+}
+
+Slice<u8> file_map(String path, u32 hints){
+	int fd = file_open_read(path);
+	if(fd < 0){ return {}; }
+
+	Slice<u8> data = {};
+	struct stat st;
+	if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0){
+		usize size = usize(st.st_size);
+		void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(p != MAP_FAILED){
+			data = Slice<u8>{ (u8*)p, size };
+			if(hints & FileMapHint_Sequential){ madvise(p, size, MADV_SEQUENTIAL); }
+			if(hints & FileMapHint_Random){ madvise(p, size, MADV_RANDOM); }
+			if(hints & FileMapHint_WillNeed){ madvise(p, size, MADV_WILLNEED); }
+		}
+	}
+	close(fd); /* The mapping keeps the file open */
+	return data;
+}
+
+void file_unmap(Slice<u8> data){
+	if(data.data){
+		munmap(data.data, data.len);
+	}
+}
+
+bool chunk_reader_open(ChunkReader* r, String path){
+	*r = ChunkReader{};
+	int fd = path == "-" ? STDIN_FILENO : file_open_read(path);
+	if(fd < 0){ return false; }
+	r->handle = (void*)uintptr(fd);
+	r->owned = fd != STDIN_FILENO;
+	return true;
+}
+
+usize chunk_read(ChunkReader* r, Slice<u8> buf){
+	int fd = int(uintptr(r->handle));
+	usize total = 0;
+	while(total < buf.len){
+		isize n = read(fd, buf.data + total, buf.len - total);
+		if(n < 0){
+			if(errno == EINTR){ continue; }
+			r->failed = true;
+			break;
+		}
+		if(n == 0){ break; }
+		total += usize(n);
+	}
+	return total;
+}
+
+void chunk_reader_close(ChunkReader* r){
+	if(r->owned){
+		close(int(uintptr(r->handle)));
+	}
+	r->handle = nullptr;
+	r->owned = false;
+}
+#endif
+
+Slice<u8> file_read(String path, Arena* arena){
+	ChunkReader r;
+	if(!chunk_reader_open(&r, path)){ return {}; }
+
+	/* The block is grown in place one chunk at a time and read into directly */
+	auto data = (u8*)arena_alloc_uninit(arena, CHUNK_READER_SIZE + 1, 1);
+	usize len = 0;
+	bool ok = data != nullptr;
+	while(ok){
+		usize n = chunk_read(&r, Slice<u8>{ data + len, CHUNK_READER_SIZE });
+		len += n;
+		if(n < CHUNK_READER_SIZE){ break; }
+		ok = arena_resize_ex(arena, data, len + CHUNK_READER_SIZE + 1, false);
+	}
+	ok = ok && !r.failed;
+	chunk_reader_close(&r);
+
+	if(!ok){
+		arena_resize_ex(arena, data, 0, false);
+		return {};
+	}
+	arena_resize_ex(arena, data, len + 1, false);
+	data[len] = 0;
+	return Slice<u8>{ data, len };
 }
@@ -2,6 +2,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdarg.h>
 
 //// Basic types & Utilities
 using i8 = int8_t;
@@ -49,7 +50,19 @@ T clamp(T lo, T x, T hi){
 
 bool ensure_ex(bool pred, char const* msg, char const* filename, int line);
 
-#define ensure(Pred, Msg) ensure_ex((Pred), (Msg), __FILE__, __LINE__)
+[[noreturn]] __attribute__((cold, noinline)) void ensure_fail(char const* msg, char const* filename, int line);
+
+[[noreturn]] __attribute__((cold, noinline)) void bounds_check_fail(usize idx, usize len, char const* filename, int line);
+
+// The predicate is evaluated inline, only a failure calls out of line
+#define ensure(Pred, Msg) (__builtin_expect(bool(Pred), 1) || (ensure_fail((Msg), __FILE__, __LINE__), false))
+
+// Index checks of Slice, List and String. Release builds define BASE_NO_BOUNDS_CHECK to remove them.
+#if defined(BASE_NO_BOUNDS_CHECK)
+#define bounds_check(Idx, Len) ((void)0)
+#else
+#define bounds_check(Idx, Len) (__builtin_expect((Idx) < (Len), 1) ? (void)0 : bounds_check_fail((Idx), (Len), __FILE__, __LINE__))
+#endif
 #define panic(Msg) panic_ex((Msg), __FILE__, __LINE__)
 #define unimplemented() panic_ex("Unimplemented", __FILE__, __LINE__)
 
@@ -60,14 +73,17 @@ struct Slice {
 	usize len;
 
 	T& operator[](usize idx){
-		ensure(idx < len, "Out of bounds access");
+		bounds_check(idx, len);
 		return data[idx];
 	}
 
 	T const& operator[](usize idx) const {
-		ensure(idx < len, "Out of bounds access");
+		bounds_check(idx, len);
 		return data[idx];
 	}
+
+	T* begin() const { return data; }
+	T* end() const { return data + len; }
 };
 
 template<class T>
@@ -84,7 +100,7 @@ Slice<T> slice(Slice<T> s, usize start, usize end) {
 template<class T>
 Slice<T> take(Slice<T> s, usize count) {
 	ensure(count <= s.len, "Cannot take more than slice length");
-	return Slice<T>{ s.data, s.count };
+	return Slice<T>{ s.data, count };
 }
 
 template<class T>
@@ -104,6 +120,9 @@ void* mem_zero(void* dest, isize n);
 
 isize mem_compare(void const* lhs, void const* rhs, isize n);
 
+// Faster than mem_compare when only equality matters, no ordering is computed
+bool mem_equal(void const* lhs, void const* rhs, usize n);
+
 constexpr static inline
 bool mem_valid_alignment(usize align){
 	return align && ((align & (align - 1)) == 0);
@@ -111,11 +130,15 @@ bool mem_valid_alignment(usize align){
 
 uintptr mem_align_forward_ptr(uintptr p, uintptr a);
 
+// Alloc and Realloc return zeroed memory (for Realloc, the bytes past old_size). The Uninit
+// variants skip that for buffers that are about to be overwritten anyway.
 enum AllocatorMode : u8 {
 	AllocatorMode_Alloc = 0,
 	AllocatorMode_Free,
 	AllocatorMode_Realloc,
 	AllocatorMode_FreeAll,
+	AllocatorMode_AllocUninit,
+	AllocatorMode_ReallocUninit,
 };
 
 using AllocatorFunc = void* (*) (void* data, AllocatorMode mode, void* ptr, usize old_size, usize new_size, usize align);
@@ -138,6 +161,19 @@ void* mem_realloc(Allocator a, void* ptr, usize old_size, usize new_size, usize
 	return a.func(a.data, AllocatorMode_Realloc, ptr, old_size, new_size, align);
 }
 
+static inline
+void* mem_alloc_uninit(Allocator a, usize size, usize align){
+	return a.func(a.data, AllocatorMode_AllocUninit, nullptr, 0, size, align);
+}
+
+static inline
+void* mem_realloc_uninit(Allocator a, void* ptr, usize old_size, usize new_size, usize align){
+	if(ptr == nullptr){
+		return mem_alloc_uninit(a, new_size, align);
+	}
+	return a.func(a.data, AllocatorMode_ReallocUninit, ptr, old_size, new_size, align);
+}
+
 static inline
 void mem_free(Allocator a, void* ptr, usize size, usize align){
 	if(ptr == nullptr){ return; }
@@ -161,6 +197,14 @@ Slice<T> make_slice(Allocator a, usize n){
 	return Slice<T>{p, n};
 }
 
+// Same as make_slice but the contents are left uninitialized
+template<class T>
+Slice<T> make_slice_uninit(Allocator a, usize n){
+	auto p = (T*)mem_alloc_uninit(a, sizeof(T) * n, alignof(T));
+	if(!p){ return Slice<T>{}; }
+	return Slice<T>{p, n};
+}
+
 //// Dynamic Array
 template<class T>
 struct List {
@@ -170,19 +214,25 @@ struct List {
 	Allocator allocator;
 
 	T& operator[](usize idx) {
-		ensure(idx < len, "Out of bounds list access");
+		bounds_check(idx, len);
 		return data[idx];
 	}
 
 	T const& operator[](usize idx) const {
-		ensure(idx < len, "Out of bounds list access");
+		bounds_check(idx, len);
 		return data[idx];
 	}
+
+	T* begin() { return data; }
+	T* end() { return data + len; }
+	T const* begin() const { return data; }
+	T const* end() const { return data + len; }
 };
 
+// Elements past len are never read, so growing does not clear the new capacity
 template<class T>
 bool resize(List<T>* arr, usize new_cap){
-	T* new_data = (T*)mem_realloc(arr->allocator, arr->data, arr->cap * sizeof(T), new_cap * sizeof(T), alignof(T));
+	T* new_data = (T*)mem_realloc_uninit(arr->allocator, arr->data, arr->cap * sizeof(T), new_cap * sizeof(T), alignof(T));
 	if(!new_data){
 		return false;
 	}
@@ -194,13 +244,26 @@ bool resize(List<T>* arr, usize new_cap){
 
 constexpr usize ARRAY_GROWTH_FACTOR = 150;
 
+// Make room for at least `cap` elements, never shrinks
+template<class T>
+bool reserve(List<T>* arr, usize cap){
+	if(cap <= arr->cap){ return true; }
+	return resize(arr, cap);
+}
+
+/* Geometric growth so repeated appends stay amortized O(1). Grows from the capacity rather than
+ * the length, callers asking for headroom past the end would otherwise get exactly that much. */
+template<class T>
+bool list_grow(List<T>* arr, usize min_cap){
+	if(min_cap <= arr->cap){ return true; }
+	usize new_cap = max<usize>(16, (arr->cap * ARRAY_GROWTH_FACTOR) / 100);
+	return resize(arr, max(new_cap, min_cap));
+}
+
 template<class T>
 bool append(List<T>* arr, T const& elem){
-	if(arr->len >= arr->cap){
-		usize new_cap = max<usize>(16, (arr->len * ARRAY_GROWTH_FACTOR) / 100);
-		if(!resize(arr, new_cap)){
-			return false;
-		}
+	if(arr->len >= arr->cap && !list_grow(arr, arr->len + 1)){
+		return false;
 	}
 
 	arr->data[arr->len] = elem;
@@ -208,6 +271,37 @@ bool append(List<T>* arr, T const& elem){
 	return true;
 }
 
+// Append all of `items`, which may point into the list itself
+template<class T>
+bool extend(List<T>* arr, Slice<T> items){
+	if(items.len == 0){ return true; }
+
+	bool aliased = items.data >= arr->data && items.data < arr->data + arr->len;
+	usize offset = aliased ? usize(items.data - arr->data) : 0;
+	if(!list_grow(arr, arr->len + items.len)){
+		return false;
+	}
+	if(aliased){
+		items.data = arr->data + offset;
+	}
+
+	mem_copy(&arr->data[arr->len], items.data, sizeof(T) * items.len);
+	arr->len += items.len;
+	return true;
+}
+
+// Grow the list by `n` elements and return them uninitialized, for filling in place.
+// Returns an empty slice on failure.
+template<class T>
+Slice<T> append_n_uninit(List<T>* arr, usize n){
+	if(!list_grow(arr, arr->len + n)){
+		return Slice<T>{};
+	}
+	Slice<T> added = { &arr->data[arr->len], n };
+	arr->len += n;
+	return added;
+}
+
 template<class T>
 bool pop(List<T>* arr){
 	if(arr->len == 0){
@@ -233,11 +327,8 @@ template<class T>
 bool insert(List<T>* arr, T const& elem, usize idx){
 	ensure(idx <= arr->len, "Out of bounds insertion");
 
-	if(arr->len >= arr->cap){
-		usize new_cap = max<usize>(16, (arr->len * ARRAY_GROWTH_FACTOR) / 100);
-		if(!resize(arr, new_cap)){
-			return false;
-		}
+	if(arr->len >= arr->cap && !list_grow(arr, arr->len + 1)){
+		return false;
 	}
 	mem_copy(&arr->data[idx + 1], &arr->data[idx], sizeof(T) * (arr->len - idx));
 	arr->data[idx] = elem;
@@ -251,11 +342,37 @@ bool remove(List<T>* arr, usize idx){
 	if(arr->len == 0){
 		return false;
 	}
-	mem_copy(&arr->data[idx], &arr->data[idx + 1], sizeof(T) * (arr->len - idx));
+	mem_copy(&arr->data[idx], &arr->data[idx + 1], sizeof(T) * (arr->len - idx - 1));
+	arr->len -= 1;
+	return true;
+}
+
+// Remove in O(1) by moving the last element into the hole, does not preserve order
+template<class T>
+bool unordered_remove(List<T>* arr, usize idx){
+	ensure(idx < arr->len, "Out of bounds deletion");
 	arr->len -= 1;
+	arr->data[idx] = arr->data[arr->len];
 	return true;
 }
 
+// Remove every element matching `pred` in a single pass, preserving the order of the others.
+// Returns the number of removed elements.
+template<class T, class Pred>
+usize remove_if(List<T>* arr, Pred pred){
+	usize write = 0;
+	for(usize read = 0; read < arr->len; read += 1){
+		if(pred(arr->data[read])){ continue; }
+		if(write != read){
+			arr->data[write] = arr->data[read];
+		}
+		write += 1;
+	}
+	usize removed = arr->len - write;
+	arr->len = write;
+	return removed;
+}
+
 template<class T>
 Slice<T> slice(List<T> const& s) {
 	return Slice<T>{s.data, s.len};
@@ -270,7 +387,7 @@ Slice<T> slice(List<T> const& s, usize start, usize end) {
 template<class T>
 Slice<T> take(List<T> const& s, usize count) {
 	ensure(count <= s.len, "Cannot take more than List length");
-	return Slice<T>{ s.data, s.count };
+	return Slice<T>{ s.data, count };
 }
 
 template<class T>
@@ -286,132 +403,1839 @@ List<T> make_list(Allocator a, usize len, usize cap){
 	return List<T>{p, len, cap, a};
 }
 
+// Same as make_list but the first `len` elements are left uninitialized
+template<class T>
+List<T> make_list_uninit(Allocator a, usize len, usize cap){
+	auto p = (T*)mem_alloc_uninit(a, sizeof(T) * cap, alignof(T));
+	if(!p){ return List<T>{}; }
+	return List<T>{p, len, cap, a};
+}
+
 template<class T>
 List<T> make_list(Allocator a){
 	return List<T>{nullptr, 0, 0, a};
 }
 
-//// Arena
-struct Arena {
-	void* data;
-	usize offset;
-	usize capacity;
-	void* last_allocation;
-	i32   region_count;
-};
+template<class T>
+void destroy(List<T>* arr){
+	if(arr->data){
+		mem_free(arr->allocator, arr->data, sizeof(T) * arr->cap, alignof(T));
+	}
+	arr->data = nullptr;
+	arr->len = 0;
+	arr->cap = 0;
+}
 
-struct ArenaRegion {
-	Arena* arena;
-	usize  offset;
-};
+//// Small List
+// List keeping its first N elements inline, the allocator is only used once it grows past N.
+// The elements are reached through data() since they move when the list spills to the heap.
+// Lists that may have spilled must be released with destroy().
+template<class T, usize N>
+struct SmallList {
+	T*        heap; /* nullptr while the elements are inline */
+	usize     len;
+	usize     cap;
+	Allocator allocator;
+	alignas(T) u8 storage[sizeof(T) * N];
 
-// Initialize an arena from a buffer
-Arena arena_from_buffer(Slice<u8> buf);
+	T* data() { return heap ? heap : (T*)storage; }
+	T const* data() const { return heap ? heap : (T const*)storage; }
 
-// Check if pointer is owned by arena
-bool arena_owns(Arena* a, void* p);
+	T& operator[](usize idx) {
+		bounds_check(idx, len);
+		return data()[idx];
+	}
 
-// Resize allocation in place, returns if it was successful
-bool arena_resize(Arena* a, void* ptr, usize new_size);
+	T const& operator[](usize idx) const {
+		bounds_check(idx, len);
+		return data()[idx];
+	}
 
-// Attempt to resize in place, otherwhise reallocate. Returns nullptr on failure
-void* arena_realloc(Arena* a, void* ptr, usize old_size, usize new_size, usize align);
+	T* begin() { return data(); }
+	T* end() { return data() + len; }
+	T const* begin() const { return data(); }
+	T const* end() const { return data() + len; }
+};
 
-// Allocate a block of memory from arena. Returns nullptr on failure
-void* arena_alloc(Arena* a, usize size, usize align);
+template<class T, usize N>
+SmallList<T, N> make_small_list(Allocator a){
+	SmallList<T, N> l;
+	l.heap = nullptr;
+	l.len = 0;
+	l.cap = N;
+	l.allocator = a;
+	return l;
+}
 
-// Reset arena, marking all allocations as free. This also ensures that there are not dangling regions.
-void arena_reset(Arena* a);
+template<class T, usize N>
+void destroy(SmallList<T, N>* arr){
+	if(arr->heap){
+		mem_free(arr->allocator, arr->heap, sizeof(T) * arr->cap, alignof(T));
+	}
+	arr->heap = nullptr;
+	arr->len = 0;
+	arr->cap = N;
+}
 
-// Begin a temporary arena region, serving as a "checkpoint"
-ArenaRegion arena_region_begin(Arena* a);
+// Make room for at least `cap` elements, never shrinks
+template<class T, usize N>
+bool reserve(SmallList<T, N>* arr, usize cap){
+	if(cap <= arr->cap){ return true; }
 
-// End the region, restoring the arena state
-void arena_region_end(ArenaRegion reg);
+	T* new_data = nullptr;
+	if(arr->heap){
+		new_data = (T*)mem_realloc_uninit(arr->allocator, arr->heap, sizeof(T) * arr->cap, sizeof(T) * cap, alignof(T));
+	}
+	else {
+		new_data = (T*)mem_alloc_uninit(arr->allocator, sizeof(T) * cap, alignof(T));
+		if(new_data){
+			mem_copy_no_overlap(new_data, arr->storage, sizeof(T) * arr->len);
+		}
+	}
+	if(!new_data){
+		return false;
+	}
 
-// Get arena in a Allocator conforming interface
-Allocator arena_allocator(Arena* a);
+	arr->heap = new_data;
+	arr->cap = cap;
+	return true;
+}
 
-template<class T>
-T* make(Arena* arena){
-	return (T*)arena_alloc(arena, sizeof(T), alignof(T));
+template<class T, usize N>
+bool small_list_grow(SmallList<T, N>* arr, usize min_cap){
+	if(min_cap <= arr->cap){ return true; }
+	usize new_cap = max<usize>(16, (arr->cap * ARRAY_GROWTH_FACTOR) / 100);
+	return reserve(arr, max(new_cap, min_cap));
 }
 
-template<class T>
-Slice<T> make_slice(Arena* arena, usize count){
-	auto p = (T*)arena_alloc(arena, sizeof(T) * count, alignof(T));
-	if(!p){
-		return Slice<T>{nullptr,0};
+template<class T, usize N>
+bool append(SmallList<T, N>* arr, T const& elem){
+	if(arr->len >= arr->cap && !small_list_grow(arr, arr->len + 1)){
+		return false;
 	}
-	return Slice<T>{p, count};
+	arr->data()[arr->len] = elem;
+	arr->len += 1;
+	return true;
 }
 
-//// Heap
-Allocator heap_allocator();
+template<class T, usize N>
+bool extend(SmallList<T, N>* arr, Slice<T> items){
+	if(items.len == 0){ return true; }
 
-//// Strings
-struct String {
-	char const* data;
-	usize len;
+	T* old_data = arr->data();
+	bool aliased = items.data >= old_data && items.data < old_data + arr->len;
+	usize offset = aliased ? usize(items.data - old_data) : 0;
+	if(!small_list_grow(arr, arr->len + items.len)){
+		return false;
+	}
+	if(aliased){
+		items.data = arr->data() + offset;
+	}
 
-	u8 operator[](usize idx) const {
-		ensure(idx < len, "Out of bounds access");
-		return data[idx];
+	mem_copy(&arr->data()[arr->len], items.data, sizeof(T) * items.len);
+	arr->len += items.len;
+	return true;
+}
+
+template<class T, usize N>
+bool pop(SmallList<T, N>* arr){
+	if(arr->len == 0){
+		return false;
 	}
+	arr->len -= 1;
+	return true;
+}
 
-	bool operator==(String s) const {
-		return !(*this != s);
+template<class T, usize N>
+bool pop(SmallList<T, N>* arr, T* elem){
+	if(arr->len == 0){
+		return false;
 	}
+	arr->len -= 1;
+	*elem = arr->data()[arr->len];
+	return true;
+}
 
-	bool operator!=(String s) const {
-		if(len != s.len){ return true; }
+template<class T, usize N>
+bool insert(SmallList<T, N>* arr, T const& elem, usize idx){
+	ensure(idx <= arr->len, "Out of bounds insertion");
+	if(arr->len >= arr->cap && !small_list_grow(arr, arr->len + 1)){
+		return false;
+	}
+	T* data = arr->data();
+	mem_copy(&data[idx + 1], &data[idx], sizeof(T) * (arr->len - idx));
+	data[idx] = elem;
+	arr->len += 1;
+	return true;
+}
 
-		for(usize i = 0; i < len; i += 1){
-			if(data[i] != s.data[i]){ return true; }
-		}
+template<class T, usize N>
+bool remove(SmallList<T, N>* arr, usize idx){
+	ensure(idx < arr->len, "Out of bounds deletion");
+	T* data = arr->data();
+	mem_copy(&data[idx], &data[idx + 1], sizeof(T) * (arr->len - idx - 1));
+	arr->len -= 1;
+	return true;
+}
 
-		return false;
+template<class T, usize N>
+bool unordered_remove(SmallList<T, N>* arr, usize idx){
+	ensure(idx < arr->len, "Out of bounds deletion");
+	T* data = arr->data();
+	arr->len -= 1;
+	data[idx] = data[arr->len];
+	return true;
+}
+
+template<class T, usize N, class Pred>
+usize remove_if(SmallList<T, N>* arr, Pred pred){
+	T* data = arr->data();
+	usize write = 0;
+	for(usize read = 0; read < arr->len; read += 1){
+		if(pred(data[read])){ continue; }
+		if(write != read){
+			data[write] = data[read];
+		}
+		write += 1;
 	}
+	usize removed = arr->len - write;
+	arr->len = write;
+	return removed;
+}
 
-	String() : data{0}, len{0} {}
+// Slices point into the inline storage until the list spills, they are invalidated by any growth
+template<class T, usize N>
+Slice<T> slice(SmallList<T, N> const& s) {
+	return Slice<T>{ (T*)s.data(), s.len };
+}
 
-	String(cstring cs) : data{cs}, len{cstring_len(cs)} {}
+template<class T, usize N>
+Slice<T> slice(SmallList<T, N> const& s, usize start, usize end) {
+	ensure(end <= s.len && end >= start, "Invalid slicing indices");
+	return Slice<T>{ (T*)&s.data()[start], end - start };
+}
 
-	String(char const* p, usize n) : data{p}, len{n} {}
+template<class T, usize N>
+Slice<T> take(SmallList<T, N> const& s, usize count) {
+	ensure(count <= s.len, "Cannot take more than List length");
+	return Slice<T>{ (T*)s.data(), count };
+}
 
-	explicit String(Slice<u8> s) : data{(char const*)s.data}, len{s.len} {}
+template<class T, usize N>
+Slice<T> skip(SmallList<T, N> const& s, usize count) {
+	ensure(count <= s.len, "Cannot skip more than slice length");
+	return Slice<T>{ (T*)&s.data()[count], s.len - count };
+}
+
+//// Deque
+// Ring buffer with O(1) push and pop at both ends. The capacity is always a power of 2 so
+// wrapping around is a mask.
+template<class T>
+struct Deque {
+	T*        data;
+	usize     head; /* Physical index of the first element */
+	usize     len;
+	usize     cap;
+	Allocator allocator;
+
+	T& operator[](usize idx) {
+		bounds_check(idx, len);
+		return data[(head + idx) & (cap - 1)];
+	}
+
+	T const& operator[](usize idx) const {
+		bounds_check(idx, len);
+		return data[(head + idx) & (cap - 1)];
+	}
 };
 
-String slice(String s);
+constexpr usize DEQUE_MIN_CAPACITY = 16;
 
-String slice(String s, usize start, usize end);
+// Grow the capacity to at least `new_cap` (rounded up to a power of 2), never shrinks
+template<class T>
+bool reserve(Deque<T>* dq, usize new_cap){
+	if(new_cap <= dq->cap){ return true; }
+	usize cap = max(DEQUE_MIN_CAPACITY, dq->cap);
+	while(cap < new_cap){ cap *= 2; }
 
-String take(String s, usize count);
+	T* new_data = (T*)mem_realloc_uninit(dq->allocator, dq->data, dq->cap * sizeof(T), cap * sizeof(T), alignof(T));
+	if(!new_data){
+		return false;
+	}
 
-String skip(String s, usize count);
+	/* Unwrap by moving whichever part of a wrapped sequence is shorter */
+	usize old_cap = dq->cap;
+	if(dq->head + dq->len > old_cap){
+		usize head_part = old_cap - dq->head;
+		usize tail_part = dq->len - head_part;
+		if(tail_part <= head_part){
+			mem_copy_no_overlap(&new_data[old_cap], &new_data[0], sizeof(T) * tail_part);
+		}
+		else {
+			usize new_head = cap - head_part;
+			mem_copy(&new_data[new_head], &new_data[dq->head], sizeof(T) * head_part);
+			dq->head = new_head;
+		}
+	}
 
-#define str_fmt(S) ((int)((S).len)), ((char const*)((S).data))
+	dq->data = new_data;
+	dq->cap = cap;
+	return true;
+}
 
-constexpr rune RUNE_ERROR = 0xfffd;
+template<class T>
+bool push_back(Deque<T>* dq, T const& elem){
+	if(dq->len >= dq->cap && !reserve(dq, dq->len + 1)){
+		return false;
+	}
+	dq->data[(dq->head + dq->len) & (dq->cap - 1)] = elem;
+	dq->len += 1;
+	return true;
+}
 
-struct RuneDecoded {
-	rune codepoint;
-	u32  size;
-};
+template<class T>
+bool push_front(Deque<T>* dq, T const& elem){
+	if(dq->len >= dq->cap && !reserve(dq, dq->len + 1)){
+		return false;
+	}
+	dq->head = (dq->head - 1) & (dq->cap - 1);
+	dq->data[dq->head] = elem;
+	dq->len += 1;
+	return true;
+}
 
-struct RuneEncoded {
-	u8  bytes[4];
-	u32 size;
-};
+template<class T>
+bool pop_back(Deque<T>* dq, T* elem = nullptr){
+	if(dq->len == 0){
+		return false;
+	}
+	dq->len -= 1;
+	if(elem){
+		*elem = dq->data[(dq->head + dq->len) & (dq->cap - 1)];
+	}
+	return true;
+}
 
-RuneEncoded rune_encode(rune r);
+template<class T>
+bool pop_front(Deque<T>* dq, T* elem = nullptr){
+	if(dq->len == 0){
+		return false;
+	}
+	if(elem){
+		*elem = dq->data[dq->head];
+	}
+	dq->head = (dq->head + 1) & (dq->cap - 1);
+	dq->len -= 1;
+	return true;
+}
 
-RuneDecoded rune_decode(u8 const* buf, u32 buflen);
+template<class T>
+void clear(Deque<T>* dq){
+	dq->head = 0;
+	dq->len = 0;
+}
 
-String clone(Allocator allocator, String s);
+template<class T>
+void destroy(Deque<T>* dq){
+	if(dq->data){
+		mem_free(dq->allocator, dq->data, sizeof(T) * dq->cap, alignof(T));
+	}
+	dq->data = nullptr;
+	dq->head = 0;
+	dq->len = 0;
+	dq->cap = 0;
+}
 
-cstring clone_to_cstring(String s, Arena* a);
+template<class T>
+Deque<T> make_deque(Allocator a){
+	return Deque<T>{nullptr, 0, 0, 0, a};
+}
 
-String arena_vprintf(Arena* arena, char const* fmt, va_list args);
+template<class T>
+Deque<T> make_deque(Allocator a, usize cap){
+	auto dq = make_deque<T>(a);
+	reserve(&dq, cap);
+	return dq;
+}
 
-String arena_printf(Arena* arena, char const* fmt, ...);
+//// Algorithms
+template<class T> static inline
+void swap(T& a, T& b){
+	T tmp = a;
+	a = b;
+	b = tmp;
+}
+
+template<class T>
+struct SortLess {
+	bool operator()(T const& a, T const& b) const { return a < b; }
+};
+
+template<class T>
+void fill(Slice<T> s, T const& value){
+	if(sizeof(T) == 1){
+		mem_set(s.data, *(u8 const*)&value, s.len);
+		return;
+	}
+	for(usize i = 0; i < s.len; i += 1){
+		s.data[i] = value;
+	}
+}
+
+// Copy min(dst.len, src.len) elements, the slices may overlap. Returns the number of elements copied.
+template<class T>
+usize copy(Slice<T> dst, Slice<T> src){
+	usize n = min(dst.len, src.len);
+	mem_copy(dst.data, src.data, sizeof(T) * n);
+	return n;
+}
+
+template<class T, class Less>
+bool is_sorted(Slice<T> s, Less less){
+	for(usize i = 1; i < s.len; i += 1){
+		if(less(s.data[i], s.data[i - 1])){ return false; }
+	}
+	return true;
+}
+
+template<class T>
+bool is_sorted(Slice<T> s){
+	return is_sorted(s, SortLess<T>{});
+}
+
+// Index of the first element not less than `value`, s.len if there is none. The loop has no
+// data dependent branches, only the number of iterations depends on the length.
+template<class T, class Less>
+usize lower_bound(Slice<T> s, T const& value, Less less){
+	if(s.len == 0){ return 0; }
+
+	T const* base = s.data;
+	usize n = s.len;
+	while(n > 1){
+		usize half = n / 2;
+		/* Both possible next probes, so the load is in flight before the comparison resolves */
+		__builtin_prefetch(base + half / 2);
+		__builtin_prefetch(base + half + half / 2);
+		base = less(base[half], value) ? base + half : base;
+		n -= half;
+	}
+	return usize(base - s.data) + usize(less(*base, value));
+}
+
+template<class T>
+usize lower_bound(Slice<T> s, T const& value){
+	return lower_bound(s, value, SortLess<T>{});
+}
+
+// Index of an element equal to `value` in a sorted slice, -1 if not found
+template<class T>
+isize binary_search(Slice<T> s, T const& value){
+	usize idx = lower_bound(s, value);
+	if(idx < s.len && !(value < s.data[idx])){
+		return isize(idx);
+	}
+	return -1;
+}
+
+constexpr usize SORT_INSERTION_THRESHOLD = 24;
+constexpr usize SORT_NINTHER_THRESHOLD = 128;
+constexpr usize SORT_PARTIAL_INSERTION_LIMIT = 8;
+
+template<class T, class Less> static inline
+void sort_insertion(T* begin, T* end, Less& less){
+	if(begin == end){ return; }
+	for(T* cur = begin + 1; cur != end; cur += 1){
+		T* sift = cur;
+		if(less(*sift, sift[-1])){
+			T tmp = *sift;
+			do {
+				*sift = sift[-1];
+				sift -= 1;
+			} while(sift != begin && less(tmp, sift[-1]));
+			*sift = tmp;
+		}
+	}
+}
+
+/* Requires an element before `begin` that is not greater than any element in the range */
+template<class T, class Less> static inline
+void sort_insertion_unguarded(T* begin, T* end, Less& less){
+	if(begin == end){ return; }
+	for(T* cur = begin + 1; cur != end; cur += 1){
+		T* sift = cur;
+		if(less(*sift, sift[-1])){
+			T tmp = *sift;
+			do {
+				*sift = sift[-1];
+				sift -= 1;
+			} while(less(tmp, sift[-1]));
+			*sift = tmp;
+		}
+	}
+}
+
+/* Gives up once more than SORT_PARTIAL_INSERTION_LIMIT elements were moved */
+template<class T, class Less> static inline
+bool sort_insertion_partial(T* begin, T* end, Less& less){
+	if(begin == end){ return true; }
+	usize moved = 0;
+	for(T* cur = begin + 1; cur != end; cur += 1){
+		T* sift = cur;
+		if(less(*sift, sift[-1])){
+			T tmp = *sift;
+			do {
+				*sift = sift[-1];
+				sift -= 1;
+			} while(sift != begin && less(tmp, sift[-1]));
+			*sift = tmp;
+			moved += usize(cur - sift);
+			if(moved > SORT_PARTIAL_INSERTION_LIMIT){ return false; }
+		}
+	}
+	return true;
+}
+
+template<class T, class Less> static inline
+void sort2(T* a, T* b, Less& less){
+	if(less(*b, *a)){ swap(*a, *b); }
+}
+
+template<class T, class Less> static inline
+void sort3(T* a, T* b, T* c, Less& less){
+	sort2(a, b, less);
+	sort2(b, c, less);
+	sort2(a, b, less);
+}
+
+template<class T, class Less> static inline
+void sort_sift_down(T* heap, usize n, usize root, Less& less){
+	for(;;){
+		usize child = 2 * root + 1;
+		if(child >= n){ break; }
+		if(child + 1 < n && less(heap[child], heap[child + 1])){ child += 1; }
+		if(!less(heap[root], heap[child])){ break; }
+		swap(heap[root], heap[child]);
+		root = child;
+	}
+}
+
+/* Fallback when too many partitions were unbalanced, guarantees O(n log n) */
+template<class T, class Less>
+void sort_heap(T* begin, T* end, Less& less){
+	usize n = usize(end - begin);
+	for(usize i = n / 2; i > 0; i -= 1){
+		sort_sift_down(begin, n, i - 1, less);
+	}
+	for(usize i = n; i > 1; i -= 1){
+		swap(begin[0], begin[i - 1]);
+		sort_sift_down(begin, i - 1, 0, less);
+	}
+}
+
+/* Partition around *begin, elements equal to the pivot go to the right. Sets `already_partitioned`
+ * when no element had to be swapped. */
+template<class T, class Less>
+T* sort_partition_right(T* begin, T* end, Less& less, bool* already_partitioned){
+	T pivot = *begin;
+	T* first = begin;
+	T* last = end;
+
+	/* The median of 3 guarantees an element not less than the pivot exists on the right */
+	do { first += 1; } while(less(*first, pivot));
+
+	if(first - 1 == begin){
+		do { last -= 1; } while(first < last && !less(*last, pivot));
+	}
+	else {
+		do { last -= 1; } while(!less(*last, pivot));
+	}
+
+	*already_partitioned = first >= last;
+
+	while(first < last){
+		swap(*first, *last);
+		do { first += 1; } while(less(*first, pivot));
+		do { last -= 1; } while(!less(*last, pivot));
+	}
+
+	T* pivot_pos = first - 1;
+	*begin = *pivot_pos;
+	*pivot_pos = pivot;
+	return pivot_pos;
+}
+
+/* Partition around *begin, elements equal to the pivot go to the left. Used when the pivot equals
+ * the element before the range, so the whole left side is a run of equal elements. */
+template<class T, class Less>
+T* sort_partition_left(T* begin, T* end, Less& less){
+	T pivot = *begin;
+	T* first = begin;
+	T* last = end;
+
+	do { last -= 1; } while(less(pivot, *last));
+
+	if(last + 1 == end){
+		do { first += 1; } while(first < last && !less(pivot, *first));
+	}
+	else {
+		do { first += 1; } while(!less(pivot, *first));
+	}
+
+	while(first < last){
+		swap(*first, *last);
+		do { last -= 1; } while(less(pivot, *last));
+		do { first += 1; } while(!less(pivot, *first));
+	}
+
+	T* pivot_pos = last;
+	*begin = *pivot_pos;
+	*pivot_pos = pivot;
+	return pivot_pos;
+}
+
+template<class T, class Less>
+void sort_pdq(T* begin, T* end, Less& less, i32 bad_allowed, bool leftmost){
+	for(;;){
+		usize size = usize(end - begin);
+		if(size < SORT_INSERTION_THRESHOLD){
+			if(leftmost){
+				sort_insertion(begin, end, less);
+			}
+			else {
+				sort_insertion_unguarded(begin, end, less);
+			}
+			return;
+		}
+
+		/* Pivot is the median of 3, or the pseudo median of 9 for larger ranges, moved to *begin */
+		usize half = size / 2;
+		if(size > SORT_NINTHER_THRESHOLD){
+			sort3(begin, begin + half, end - 1, less);
+			sort3(begin + 1, begin + (half - 1), end - 2, less);
+			sort3(begin + 2, begin + (half + 1), end - 3, less);
+			sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+			swap(*begin, begin[half]);
+		}
+		else {
+			sort3(begin + half, begin, end - 1, less);
+		}
+
+		/* The pivot equals the element before the range, put all the equal elements to the left and skip them */
+		if(!leftmost && !less(begin[-1], *begin)){
+			begin = sort_partition_left(begin, end, less) + 1;
+			continue;
+		}
+
+		bool already_partitioned = false;
+		T* pivot_pos = sort_partition_right(begin, end, less, &already_partitioned);
+
+		usize left_size = usize(pivot_pos - begin);
+		usize right_size = usize(end - (pivot_pos + 1));
+		bool unbalanced = left_size < size / 8 || right_size < size / 8;
+
+		if(unbalanced){
+			bad_allowed -= 1;
+			if(bad_allowed == 0){
+				sort_heap(begin, end, less);
+				return;
+			}
+
+			/* Break up patterns that produce bad pivots */
+			if(left_size >= SORT_INSERTION_THRESHOLD){
+				swap(begin[0], begin[left_size / 4]);
+				swap(pivot_pos[-1], pivot_pos[-isize(left_size / 4)]);
+				if(left_size > SORT_NINTHER_THRESHOLD){
+					swap(begin[1], begin[left_size / 4 + 1]);
+					swap(begin[2], begin[left_size / 4 + 2]);
+					swap(pivot_pos[-2], pivot_pos[-isize(left_size / 4 + 1)]);
+					swap(pivot_pos[-3], pivot_pos[-isize(left_size / 4 + 2)]);
+				}
+			}
+			if(right_size >= SORT_INSERTION_THRESHOLD){
+				swap(pivot_pos[1], pivot_pos[1 + right_size / 4]);
+				swap(end[-1], end[-isize(right_size / 4)]);
+				if(right_size > SORT_NINTHER_THRESHOLD){
+					swap(pivot_pos[2], pivot_pos[2 + right_size / 4]);
+					swap(pivot_pos[3], pivot_pos[3 + right_size / 4]);
+					swap(end[-2], end[-isize(1 + right_size / 4)]);
+					swap(end[-3], end[-isize(2 + right_size / 4)]);
+				}
+			}
+		}
+		else if(already_partitioned){
+			/* Likely sorted already, try to finish with a bounded amount of insertion sort */
+			if(sort_insertion_partial(begin, pivot_pos, less) && sort_insertion_partial(pivot_pos + 1, end, less)){
+				return;
+			}
+		}
+
+		/* Recurse into the smaller side to bound the stack depth */
+		if(left_size < right_size){
+			sort_pdq(begin, pivot_pos, less, bad_allowed, leftmost);
+			begin = pivot_pos + 1;
+			leftmost = false;
+		}
+		else {
+			sort_pdq(pivot_pos + 1, end, less, bad_allowed, false);
+			end = pivot_pos;
+		}
+	}
+}
+
+// Unstable in-place sort (pattern-defeating quicksort). O(n log n) worst case, linear on sorted,
+// reverse sorted and mostly equal inputs.
+template<class T, class Less>
+void sort(Slice<T> s, Less less){
+	if(s.len < 2){ return; }
+	i32 log2 = 0;
+	for(usize n = s.len; n > 1; n >>= 1){ log2 += 1; }
+	sort_pdq(s.data, s.data + s.len, less, log2, true);
+}
+
+template<class T>
+void sort(Slice<T> s){
+	sort(s, SortLess<T>{});
+}
+
+template<usize Size> struct UnsignedOfSize;
+template<> struct UnsignedOfSize<1> { using Type = u8; };
+template<> struct UnsignedOfSize<2> { using Type = u16; };
+template<> struct UnsignedOfSize<4> { using Type = u32; };
+template<> struct UnsignedOfSize<8> { using Type = u64; };
+
+// Stable LSD radix sort on the unsigned integer returned by `key`, one pass per byte of the key.
+// Passes where every element has the same digit are skipped. Needs a scratch buffer of s.len
+// elements from `scratch`, returns false if it could not be allocated.
+template<class T, class KeyFunc>
+bool radix_sort(Slice<T> s, Allocator scratch, KeyFunc key){
+	using Key = decltype(key(s.data[0]));
+	static_assert(Key(0) < Key(-1), "Radix sort keys must be unsigned integers");
+	constexpr usize digits = sizeof(Key);
+
+	if(s.len < 2){ return true; }
+
+	auto tmp = make_slice_uninit<T>(scratch, s.len);
+	if(!tmp.data){ return false; }
+
+	/* All histograms in a single pass */
+	usize counts[digits][256] = {};
+	for(usize i = 0; i < s.len; i += 1){
+		Key k = key(s.data[i]);
+		for(usize d = 0; d < digits; d += 1){
+			counts[d][(k >> (d * 8)) & 0xff] += 1;
+		}
+	}
+
+	T* src = s.data;
+	T* dst = tmp.data;
+	for(usize d = 0; d < digits; d += 1){
+		usize* count = counts[d];
+		if(count[(key(src[0]) >> (d * 8)) & 0xff] == s.len){ continue; }
+
+		usize offset = 0;
+		for(usize b = 0; b < 256; b += 1){
+			usize c = count[b];
+			count[b] = offset;
+			offset += c;
+		}
+
+		for(usize i = 0; i < s.len; i += 1){
+			dst[count[(key(src[i]) >> (d * 8)) & 0xff]++] = src[i];
+		}
+		swap(src, dst);
+	}
+
+	if(src != s.data){
+		mem_copy_no_overlap(s.data, src, sizeof(T) * s.len);
+	}
+	mem_free(scratch, tmp.data, sizeof(T) * tmp.len, alignof(T));
+	return true;
+}
+
+// Radix sort of integers, signed values are ordered by flipping the sign bit
+template<class T>
+bool radix_sort(Slice<T> s, Allocator scratch){
+	static_assert(T(1) / T(2) == T(0), "Only integers can be radix sorted without a key function");
+	using Key = typename UnsignedOfSize<sizeof(T)>::Type;
+	constexpr Key flip = (T(-1) < T(0)) ? Key(Key(1) << (sizeof(T) * 8 - 1)) : Key(0);
+	return radix_sort(s, scratch, [](T const& v){ return Key(Key(v) ^ flip); });
+}
+
+//// Virtual memory
+// Granularity of commits and protection changes
+usize os_page_size();
+
+// Reserve address space without backing memory, returns nullptr on failure
+void* os_mem_reserve(usize size);
+
+// Back a reserved range with zero-initialized read/write pages
+bool os_mem_commit(void* p, usize size);
+
+// Return the physical pages of a range to the OS, the range stays reserved
+void os_mem_decommit(void* p, usize size);
+
+// Release a range obtained from os_mem_reserve
+void os_mem_release(void* p, usize size);
+
+// Ask the OS to back a range with transparent huge pages, returns false if unsupported
+bool os_mem_advise_huge_pages(void* p, usize size);
+
+//// Arena
+enum ArenaFlag : u32 {
+	ArenaFlag_Virtual         = 1 << 0, /* Set by arena_create_virtual, capacity is reserved but not committed */
+	ArenaFlag_HugePages       = 1 << 1, /* Align the reservation to 2 MiB and request transparent huge pages */
+	ArenaFlag_DecommitOnReset = 1 << 2, /* Return committed pages to the OS on arena_reset */
+};
+
+struct Arena {
+	void* data;
+	usize offset;
+	usize capacity;
+	void* last_allocation;
+	i32   region_count;
+	u32   flags;
+	usize committed;
+};
+
+struct ArenaRegion {
+	Arena* arena;
+	usize  offset;
+};
+
+// Initialize an arena from a buffer
+Arena arena_from_buffer(Slice<u8> buf);
+
+// Reserve `reserve` bytes of address space and commit pages only as the arena grows into them.
+// On failure the arena has no capacity and every allocation returns nullptr.
+Arena arena_create_virtual(usize reserve, u32 flags = 0);
+
+// Release the memory of an arena created with arena_create_virtual
+void arena_destroy(Arena* a);
+
+// Check if pointer is owned by arena
+bool arena_owns(Arena* a, void* p);
+
+// Resize allocation in place, returns if it was successful
+bool arena_resize(Arena* a, void* ptr, usize new_size);
+
+// Attempt to resize in place, otherwhise reallocate. Returns nullptr on failure
+void* arena_realloc(Arena* a, void* ptr, usize old_size, usize new_size, usize align);
+
+// Allocate a block of memory from arena. Returns nullptr on failure
+void* arena_alloc(Arena* a, usize size, usize align);
+
+// Same as arena_alloc without zeroing the block
+void* arena_alloc_uninit(Arena* a, usize size, usize align);
+
+// Reset arena, marking all allocations as free. This also ensures that there are not dangling regions.
+void arena_reset(Arena* a);
+
+// Begin a temporary arena region, serving as a "checkpoint"
+ArenaRegion arena_region_begin(Arena* a);
+
+// End the region, restoring the arena state
+void arena_region_end(ArenaRegion reg);
+
+// Get arena in a Allocator conforming interface
+Allocator arena_allocator(Arena* a);
+
+template<class T>
+T* make(Arena* arena){
+	return (T*)arena_alloc(arena, sizeof(T), alignof(T));
+}
+
+template<class T>
+Slice<T> make_slice(Arena* arena, usize count){
+	auto p = (T*)arena_alloc(arena, sizeof(T) * count, alignof(T));
+	if(!p){
+		return Slice<T>{nullptr,0};
+	}
+	return Slice<T>{p, count};
+}
+
+template<class T>
+Slice<T> make_slice_uninit(Arena* arena, usize count){
+	auto p = (T*)arena_alloc_uninit(arena, sizeof(T) * count, alignof(T));
+	if(!p){
+		return Slice<T>{nullptr,0};
+	}
+	return Slice<T>{p, count};
+}
+
+//// Heap
+// malloc backed allocator, alignments above alignof(max_align_t) are supported by over-allocating
+Allocator heap_allocator();
+
+//// Atomics
+enum MemoryOrder : int {
+	MemoryOrder_Relaxed = __ATOMIC_RELAXED,
+	MemoryOrder_Acquire = __ATOMIC_ACQUIRE,
+	MemoryOrder_Release = __ATOMIC_RELEASE,
+	MemoryOrder_AcqRel  = __ATOMIC_ACQ_REL,
+	MemoryOrder_SeqCst  = __ATOMIC_SEQ_CST,
+};
+
+template<class T> static inline
+T atomic_load(T const* p, MemoryOrder order = MemoryOrder_SeqCst){
+	return __atomic_load_n(p, order);
+}
+
+template<class T> static inline
+void atomic_store(T* p, T v, MemoryOrder order = MemoryOrder_SeqCst){
+	__atomic_store_n(p, v, order);
+}
+
+template<class T> static inline
+T atomic_exchange(T* p, T v, MemoryOrder order = MemoryOrder_SeqCst){
+	return __atomic_exchange_n(p, v, order);
+}
+
+// Compare and swap, on failure `expected` receives the current value
+template<class T> static inline
+bool atomic_cas(T* p, T* expected, T desired, MemoryOrder success = MemoryOrder_SeqCst, MemoryOrder failure = MemoryOrder_SeqCst){
+	return __atomic_compare_exchange_n(p, expected, desired, false, success, failure);
+}
+
+// Returns the value before the addition
+template<class T> static inline
+T atomic_add(T* p, T v, MemoryOrder order = MemoryOrder_SeqCst){
+	return __atomic_fetch_add(p, v, order);
+}
+
+// Returns the value before the subtraction
+template<class T> static inline
+T atomic_sub(T* p, T v, MemoryOrder order = MemoryOrder_SeqCst){
+	return __atomic_fetch_sub(p, v, order);
+}
+
+static inline
+void atomic_fence(MemoryOrder order = MemoryOrder_SeqCst){
+	__atomic_thread_fence(order);
+}
+
+// Hint to the CPU that we are in a spin-wait loop
+static inline
+void cpu_relax(){
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	__asm__ volatile("yield");
+#endif
+}
+
+struct Spinlock {
+	i32 state;
+};
+
+static inline
+void spinlock_acquire(Spinlock* l){
+	for(;;){
+		if(atomic_exchange(&l->state, 1, MemoryOrder_Acquire) == 0){ return; }
+		while(atomic_load(&l->state, MemoryOrder_Relaxed) != 0){
+			cpu_relax();
+		}
+	}
+}
+
+static inline
+void spinlock_release(Spinlock* l){
+	atomic_store(&l->state, 0, MemoryOrder_Release);
+}
+
+//// Threads
+using ThreadProc = void (*)(void* arg);
+
+struct Thread {
+	void* handle;
+};
+
+struct Semaphore {
+	void* handle;
+};
+
+// Spawn a new OS thread running `proc(arg)`, handle is null on failure
+Thread thread_create(ThreadProc proc, void* arg);
+
+// Wait for thread to finish and release its resources
+void thread_join(Thread t);
+
+// Give up the rest of the current time slice
+void thread_yield();
+
+// Number of logical processors available to the process
+i32 cpu_count();
+
+Semaphore semaphore_create(i32 initial);
+
+void semaphore_destroy(Semaphore s);
+
+// Block until the count is positive then decrement it
+void semaphore_wait(Semaphore s);
+
+// Increment the count by `n`, waking up to `n` waiters
+void semaphore_post(Semaphore s, i32 n = 1);
+
+//// CPU
+enum CPUFeature : u32 {
+	CPUFeature_SSE2       = 1 << 0,
+	CPUFeature_SSSE3      = 1 << 1,
+	CPUFeature_SSE41      = 1 << 2,
+	CPUFeature_SSE42      = 1 << 3,
+	CPUFeature_PCLMUL     = 1 << 4,
+	CPUFeature_AVX        = 1 << 5,
+	CPUFeature_AVX2       = 1 << 6,
+	CPUFeature_AVX512F    = 1 << 7,
+	CPUFeature_AVX512BW   = 1 << 8,
+	CPUFeature_AVX512VL   = 1 << 9,
+	CPUFeature_VPCLMULQDQ = 1 << 10,
+};
+
+// Bitset of CPUFeature supported by both the processor and the OS, detected on first call
+u32 cpu_features();
+
+static inline
+bool cpu_has(u32 features){
+	return (cpu_features() & features) == features;
+}
+
+//// Time
+// Monotonic clock in nanoseconds, only meaningful as a difference between two calls
+u64 time_now();
+
+//// Pool
+// Intrusive free list node, lives inside free blocks
+struct PoolBlock {
+	PoolBlock* next;
+};
+
+struct PoolChunk {
+	PoolChunk* next;
+	usize      size;
+};
+
+// Fixed size block allocator. Blocks are carved from chunks obtained from the backing allocator
+// and kept on an intrusive free list, chunks are only returned on pool_destroy.
+struct Pool {
+	usize      block_size;
+	usize      block_align;
+	usize      blocks_per_chunk;
+	PoolBlock* free_list;
+	PoolChunk* chunks;
+	Allocator  backing;
+	Spinlock   lock;
+};
+
+// Single threaded front end of a Pool. Blocks move between the cache and the pool in batches so
+// the pool lock is only taken once every few dozen allocations.
+struct PoolCache {
+	Pool*      pool;
+	PoolBlock* free_list;
+	usize      count;
+};
+
+Pool pool_create(usize block_size, usize block_align, usize blocks_per_chunk, Allocator backing);
+
+// Release every chunk, all blocks (including the ones held by caches) become invalid
+void pool_destroy(Pool* p);
+
+// Get a zeroed block, returns nullptr if a new chunk could not be allocated. Thread safe.
+void* pool_alloc(Pool* p);
+
+// Same as pool_alloc without zeroing the block
+void* pool_alloc_uninit(Pool* p);
+
+// Thread safe
+void pool_free(Pool* p, void* ptr);
+
+// Allocator interface for blocks of up to block_size bytes, FreeAll is the same as pool_destroy
+Allocator pool_allocator(Pool* p);
+
+PoolCache pool_cache_create(Pool* p);
+
+// Get a zeroed block, refilling the cache from the pool when empty
+void* pool_cache_alloc(PoolCache* c);
+
+// Same as pool_cache_alloc without zeroing the block
+void* pool_cache_alloc_uninit(PoolCache* c);
+
+// Blocks may be freed to any cache of the same pool, not only the one that allocated them
+void pool_cache_free(PoolCache* c, void* ptr);
+
+// Return all cached blocks to the pool
+void pool_cache_flush(PoolCache* c);
+
+// Allocator interface to the cache, must only be used by the thread owning the cache
+Allocator pool_cache_allocator(PoolCache* c);
+
+//// Cached heap
+// General purpose allocator with power of two size classes from 16 B to 32 KiB, each class is a
+// Pool with a cache per thread so most allocations and frees never touch shared state. Blocks are
+// aligned to their class size, which also keeps blocks of 64 bytes and up on their own cache lines.
+// Larger requests go to heap_allocator. Frees must pass the same size and alignment as the
+// allocation, like every other Allocator.
+Allocator cached_heap_allocator();
+
+// Return the calling thread's cached blocks to the shared pools, call before a thread exits
+void cached_heap_thread_flush();
+
+//// Tracking allocator
+constexpr usize ALLOCATION_HISTOGRAM_BUCKETS = 32;
+
+// Some counters are derived when read, so only use the copies returned by the tracker functions.
+// Counters are updated with relaxed atomics, a snapshot taken while other threads allocate is not
+// guaranteed to be consistent across fields. Live and peak bytes are attributed to whichever site
+// performs the operation, so a site freeing memory allocated elsewhere can go negative.
+struct AllocationStats {
+	u64 alloc_count;
+	u64 free_count;
+	u64 failed_count;
+	u64 realloc_grow_count;
+	u64 realloc_shrink_count;
+	u64 realloc_move_count;  /* Reallocations that returned a different pointer */
+	u64 bytes_allocated;     /* Total requested by Alloc plus growth from Realloc */
+	u64 bytes_freed;         /* Total released by Free plus shrinkage from Realloc */
+	i64 live_bytes;
+	i64 peak_bytes;
+	u64 size_histogram[ALLOCATION_HISTOGRAM_BUCKETS]; /* Bucket i counts Alloc requests of [2^i, 2^(i+1)) bytes */
+};
+
+struct AllocationTracker;
+
+struct AllocationSite {
+	cstring            file;
+	i32                line;
+	AllocationStats    stats;
+	AllocationTracker* tracker;
+	AllocationSite*    next;
+};
+
+// Forwards to `inner` and keeps statistics per call site as well as in total. Must not be moved
+// once a tracking allocator has been handed out.
+struct AllocationTracker {
+	Allocator       inner;
+	AllocationStats total; /* Only live_bytes and peak_bytes are maintained, the rest is summed from the sites */
+	AllocationSite* sites;
+	Spinlock        lock;
+};
+
+AllocationTracker allocation_tracker_create(Allocator inner);
+
+// Release the site records, allocators obtained from the tracker become invalid
+void allocation_tracker_destroy(AllocationTracker* t);
+
+// Allocator recording into the site (file, line), the site record is created on first use.
+// Looking up the site takes a lock, keep the returned allocator around instead of calling this
+// per allocation. Thread safe.
+Allocator tracking_allocator_ex(AllocationTracker* t, cstring file, i32 line);
+
+#define tracking_allocator(Tracker) tracking_allocator_ex((Tracker), __FILE__, __LINE__)
+
+// Copy of the total statistics
+AllocationStats allocation_tracker_totals(AllocationTracker* t);
+
+// Copy up to out.len sites, sorted by bytes allocated (highest first). Returns the number of
+// sites copied.
+usize allocation_tracker_snapshot(AllocationTracker* t, Slice<AllocationSite> out);
+
+// Print totals, the size histogram and the `max_sites` busiest sites to stderr
+void allocation_tracker_dump(AllocationTracker* t, usize max_sites = 16);
+
+//// Strings
+struct String {
+	char const* data;
+	usize len;
+
+	u8 operator[](usize idx) const {
+		bounds_check(idx, len);
+		return data[idx];
+	}
+
+	bool operator==(String s) const {
+		return !(*this != s);
+	}
+
+	bool operator!=(String s) const {
+		return len != s.len || !mem_equal(data, s.data, len);
+	}
+
+	String() : data{0}, len{0} {}
+
+	String(cstring cs) : data{cs}, len{cstring_len(cs)} {}
+
+	String(char const* p, usize n) : data{p}, len{n} {}
+
+	explicit String(Slice<u8> s) : data{(char const*)s.data}, len{s.len} {}
+};
+
+String slice(String s);
+
+String slice(String s, usize start, usize end);
+
+String take(String s, usize count);
+
+String skip(String s, usize count);
+
+// Index of the first occurrence of `b`, -1 if absent
+isize index_byte(String s, u8 b);
+
+// Index of the last occurrence of `b`, -1 if absent
+isize last_index_byte(String s, u8 b);
+
+// Index of the first occurrence of `sub`, -1 if absent. An empty `sub` is found at 0.
+isize find(String s, String sub);
+
+struct SplitIterator {
+	String rest;
+	String sep;
+	String part;
+	bool   last; /* No separator left, `part` is the remainder */
+	bool   done;
+
+	String operator*() const { return part; }
+
+	SplitIterator& operator++(){
+		if(last){
+			done = true;
+			return *this;
+		}
+		isize idx = find(rest, sep);
+		if(idx < 0){
+			part = rest;
+			rest = String();
+			last = true;
+		}
+		else {
+			part = String(rest.data, usize(idx));
+			rest = String(rest.data + idx + sep.len, rest.len - usize(idx) - sep.len);
+		}
+		return *this;
+	}
+
+	bool operator!=(SplitIterator const& other) const { return done != other.done; }
+};
+
+struct StringSplit {
+	String s;
+	String sep;
+
+	SplitIterator begin() const {
+		SplitIterator it = { s, sep, String(), false, false };
+		return ++it;
+	}
+
+	SplitIterator end() const { return { String(), sep, String(), true, true }; }
+};
+
+// Iterate over the parts of `s` between occurrences of `sep`, including empty ones. A string
+// without `sep` yields itself once, so an empty string yields one empty part.
+static inline
+StringSplit split(String s, String sep){
+	ensure(sep.len > 0, "Separator must not be empty");
+	return StringSplit{ s, sep };
+}
+
+#define str_fmt(S) ((int)((S).len)), ((char const*)((S).data))
+
+constexpr rune RUNE_ERROR = 0xfffd;
+
+struct RuneDecoded {
+	rune codepoint;
+	u32  size;
+};
+
+struct RuneEncoded {
+	u8  bytes[4];
+	u32 size;
+};
+
+RuneEncoded rune_encode(rune r);
+
+RuneDecoded rune_decode(u8 const* buf, u32 buflen);
+
+String clone(Allocator allocator, String s);
+
+cstring clone_to_cstring(String s, Arena* a);
+
+String arena_vprintf(Arena* arena, char const* fmt, va_list args);
+
+String arena_printf(Arena* arena, char const* fmt, ...);
+
+//// Files
+enum FileMapHint : u32 {
+	FileMapHint_None       = 0,
+	FileMapHint_Sequential = 1 << 0, /* Read ahead aggressively */
+	FileMapHint_Random     = 1 << 1, /* Do not read ahead */
+	FileMapHint_WillNeed   = 1 << 2, /* Start reading the whole file in right away */
+};
+
+// Map a whole file read-only, writing to the returned memory faults. Returns an empty slice for
+// empty files, inputs that cannot be mapped such as pipes and devices, and on failure; those are
+// read with a ChunkReader instead. The contents change if the file is modified in place and
+// reading past a truncation faults, so only map files that are replaced rather than rewritten.
+Slice<u8> file_map(String path, u32 hints = FileMapHint_Sequential);
+
+// Release a mapping returned by file_map
+void file_unmap(Slice<u8> data);
+
+constexpr usize CHUNK_READER_SIZE = 64 * 1024;
+
+// Sequential reader for any input, including the ones file_map rejects
+struct ChunkReader {
+	void* handle;
+	bool  owned;  /* Standard input is not closed */
+	bool  failed;
+};
+
+// Open `path` for reading, "-" reads standard input. Returns false on failure.
+bool chunk_reader_open(ChunkReader* r, String path);
+
+// Fill `buf` unless the input ends first, returns the number of bytes read. Returns 0 at the end of
+// the input or on failure, `failed` tells them apart.
+usize chunk_read(ChunkReader* r, Slice<u8> buf);
+
+void chunk_reader_close(ChunkReader* r);
+
+// Read a whole input into the arena CHUNK_READER_SIZE bytes at a time, without zeroing or copying
+// it. The contents are followed by a null terminator which is not part of the slice. Returns an
+// empty slice with a null pointer on failure.
+Slice<u8> file_read(String path, Arena* arena);
+
+//// UTF-8
+// Every function below treats invalid input exactly like a loop over rune_decode: each byte that
+// does not start a valid sequence is one RUNE_ERROR. Encoding follows rune_encode, so runes that
+// are surrogates or out of range become U+FFFD.
+
+// Returns false if `s` is not valid UTF-8, `invalid_at` receives the offset of the first bad byte
+bool utf8_validate(String s, usize* invalid_at = nullptr);
+
+// Number of runes rune_decode would produce over `s`
+usize utf8_rune_count(String s);
+
+// Decode to UTF-32, returns an empty slice on allocation failure
+Slice<rune> utf8_to_utf32(Allocator a, String s);
+
+// Decode to UTF-16, runes above U+FFFF become surrogate pairs. Returns an empty slice on
+// allocation failure.
+Slice<u16> utf8_to_utf16(Allocator a, String s);
+
+String utf32_to_utf8(Allocator a, Slice<rune> runes);
+
+// Unpaired surrogates are encoded as U+FFFD
+String utf16_to_utf8(Allocator a, Slice<u16> units);
+
+//// String builder
+// Contiguous byte buffer that grows geometrically, so appending stays amortized O(1)
+struct StringBuilder {
+	List<u8> buf;
+};
+
+StringBuilder builder_create(usize cap, Allocator alloc);
+
+void builder_destroy(StringBuilder* sb);
+
+// Returns false if the buffer could not grow, the builder is left unchanged
+bool builder_append(StringBuilder* sb, String str);
+
+bool builder_append_byte(StringBuilder* sb, u8 b);
+
+// Format straight into the builder's buffer, no temporary string is created. Returns false if
+// the buffer could not grow, the builder is left unchanged.
+bool builder_printf(StringBuilder* sb, char const* fmt, ...);
+
+bool builder_vprintf(StringBuilder* sb, char const* fmt, va_list args);
+
+// Keep the capacity, drop the contents
+void builder_reset(StringBuilder* sb);
+
+// View of the contents, invalidated by the next append
+String builder_string(StringBuilder const& sb);
+
+Slice<u8> builder_bytes(StringBuilder const& sb);
+
+//// Formatting
+// Typed alternatives to builder_printf and arena_printf for hot output paths, they skip parsing a
+// format string. Hex digits are lowercase, min_digits pads with zeros like "%0*x" (at most 16).
+// f64 is written like "%.*f" and correctly rounded while |v| * 10^precision < 2^53, exact ties
+// round away from zero like arena_printf (glibc rounds them to even). Larger values and
+// precisions above 15 go through the printf implementation.
+bool builder_append_u64(StringBuilder* sb, u64 v);
+
+bool builder_append_i64(StringBuilder* sb, i64 v);
+
+bool builder_append_hex(StringBuilder* sb, u64 v, u32 min_digits = 1);
+
+bool builder_append_f64(StringBuilder* sb, f64 v, u32 precision = 6);
+
+String arena_format_u64(Arena* arena, u64 v);
+
+String arena_format_i64(Arena* arena, i64 v);
+
+String arena_format_hex(Arena* arena, u64 v, u32 min_digits = 1);
+
+String arena_format_f64(Arena* arena, f64 v, u32 precision = 6);
+
+//// Hashing
+// Finalizer of a 64 bit integer, every input bit affects every output bit
+constexpr static inline
+u64 hash_u64(u64 x){
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ull;
+	x ^= x >> 33;
+	return x;
+}
+
+/* Little endian loads. The byte-wise templates are the constant expression path (string
+ * literals), runtime hashing goes through the u8 overloads. */
+static inline
+u64 hash_read8(u8 const* p){
+	u64 v;
+	__builtin_memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+static inline
+u64 hash_read4(u8 const* p){
+	u32 v;
+	__builtin_memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	return v;
+}
+
+template<class Byte> constexpr static inline
+u64 hash_read8(Byte const* p){
+	return u64(u8(p[0])) | (u64(u8(p[1])) << 8) | (u64(u8(p[2])) << 16) | (u64(u8(p[3])) << 24) |
+	       (u64(u8(p[4])) << 32) | (u64(u8(p[5])) << 40) | (u64(u8(p[6])) << 48) | (u64(u8(p[7])) << 56);
+}
+
+template<class Byte> constexpr static inline
+u64 hash_read4(Byte const* p){
+	return u64(u8(p[0])) | (u64(u8(p[1])) << 8) | (u64(u8(p[2])) << 16) | (u64(u8(p[3])) << 24);
+}
+
+/* 64x64 -> 128 bit multiply folded back to 64 bits */
+constexpr static inline
+u64 hash_mix(u64 a, u64 b){
+	__uint128_t r = __uint128_t(a) * __uint128_t(b);
+	return u64(r) ^ u64(r >> 64);
+}
+
+constexpr u64 HASH64_SECRET[4] = {
+	0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+};
+
+// wyhash: keys up to 16 bytes take two loads and two multiplies, longer inputs are consumed 48
+// bytes at a time by three independent multiply chains. Usable in constant expressions.
+template<class Byte> constexpr
+u64 hash64_ex(Byte const* p, usize len, u64 seed){
+	u64 const* s = HASH64_SECRET;
+	seed ^= hash_mix(seed ^ s[0], s[1]);
+	u64 a = 0;
+	u64 b = 0;
+
+	if(len <= 16){
+		if(len >= 4){
+			usize mid = (len >> 3) << 2;
+			a = (hash_read4(p) << 32) | hash_read4(p + mid);
+			b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - mid);
+		}
+		else if(len > 0){
+			a = (u64(u8(p[0])) << 16) | (u64(u8(p[len >> 1])) << 8) | u64(u8(p[len - 1]));
+		}
+	}
+	else {
+		usize i = len;
+		if(i > 48){
+			u64 see1 = seed;
+			u64 see2 = seed;
+			do {
+				seed = hash_mix(hash_read8(p) ^ s[1], hash_read8(p + 8) ^ seed);
+				see1 = hash_mix(hash_read8(p + 16) ^ s[2], hash_read8(p + 24) ^ see1);
+				see2 = hash_mix(hash_read8(p + 32) ^ s[3], hash_read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while(i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while(i > 16){
+			seed = hash_mix(hash_read8(p) ^ s[1], hash_read8(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		a = hash_read8(p + i - 16);
+		b = hash_read8(p + i - 8);
+	}
+
+	a ^= s[1];
+	b ^= seed;
+	__uint128_t r = __uint128_t(a) * __uint128_t(b);
+	a = u64(r);
+	b = u64(r >> 64);
+	return hash_mix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+static inline
+u64 hash64(Slice<u8> buf, u64 seed = 0){
+	return hash64_ex(buf.data, buf.len, seed);
+}
+
+static inline
+u64 hash64(String s, u64 seed = 0){
+	return hash64_ex((u8 const*)s.data, s.len, seed);
+}
+
+// String literals hash at compile time and agree with hash64(String(...)). Only for literals, the
+// whole array but the last byte is hashed so a buffer would include whatever follows its null.
+template<usize N> constexpr
+u64 hash64_literal(char const (&s)[N], u64 seed = 0){
+	return hash64_ex(s, N - 1, seed);
+}
+
+template<class K>
+struct MapHash {
+	u64 operator()(K const& key) const { return hash_u64(u64(key)); }
+};
+
+template<class T>
+struct MapHash<T*> {
+	u64 operator()(T* key) const { return hash_u64(u64(uintptr(key))); }
+};
+
+template<>
+struct MapHash<String> {
+	u64 operator()(String const& key) const { return hash64(key); }
+};
+
+//// Map
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+constexpr usize MAP_GROUP_WIDTH = 16;
+constexpr usize MAP_MIN_CAPACITY = MAP_GROUP_WIDTH;
+constexpr u8 MAP_CTRL_EMPTY = 0x80;
+
+template<class K, class V>
+struct MapEntry {
+	K key;
+	V value;
+};
+
+// `Entry` is const qualified when iterating a const Map
+template<class K, class V, class Entry = MapEntry<K, V>>
+struct MapIterator {
+	Entry*    entries;
+	u8 const* ctrl;
+	usize     idx;
+	usize     cap;
+
+	Entry& operator*() const { return entries[idx]; }
+
+	MapIterator& operator++(){
+		do { idx += 1; } while(idx < cap && ctrl[idx] == MAP_CTRL_EMPTY);
+		return *this;
+	}
+
+	bool operator!=(MapIterator const& other) const { return idx != other.idx; }
+};
+
+// Open addressing hash map with linear probing over groups of 16 control bytes, the top 7 bits of
+// the hash of each occupied slot are kept in its control byte so a whole group is matched with
+// one SSE2 compare. Deleting shifts the following entries back instead of leaving tombstones, so
+// probe sequences never get longer with churn. The control bytes of the first group are mirrored
+// past the end so groups can be loaded at any position without wrapping. Keys are stored by value,
+// String keys are views and their bytes must outlive the map.
+template<class K, class V, class Hash = MapHash<K>>
+struct Map {
+	MapEntry<K, V>* entries;
+	u8*             ctrl;
+	usize           len;
+	usize           cap;
+	Allocator       allocator;
+
+	MapIterator<K, V> begin() {
+		MapIterator<K, V> it = { entries, ctrl, 0, cap };
+		if(cap && ctrl[0] == MAP_CTRL_EMPTY){ ++it; }
+		return it;
+	}
+
+	MapIterator<K, V> end() { return { entries, ctrl, cap, cap }; }
+
+	MapIterator<K, V, MapEntry<K, V> const> begin() const {
+		MapIterator<K, V, MapEntry<K, V> const> it = { entries, ctrl, 0, cap };
+		if(cap && ctrl[0] == MAP_CTRL_EMPTY){ ++it; }
+		return it;
+	}
+
+	MapIterator<K, V, MapEntry<K, V> const> end() const { return { entries, ctrl, cap, cap }; }
+};
+
+/* Bit i is set when ctrl[i] == byte */
+static inline
+u32 map_group_match(u8 const* ctrl, u8 byte){
+#if defined(__SSE2__)
+	__m128i group = _mm_loadu_si128((__m128i const*)ctrl);
+	return u32(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(char(byte)))));
+#else
+	u32 mask = 0;
+	for(usize i = 0; i < MAP_GROUP_WIDTH; i += 1){
+		mask |= u32(ctrl[i] == byte) << i;
+	}
+	return mask;
+#endif
+}
+
+template<class K, class V, class Hash>
+void map_set_ctrl(Map<K, V, Hash>* m, usize slot, u8 value){
+	m->ctrl[slot] = value;
+	if(slot < MAP_GROUP_WIDTH){
+		m->ctrl[m->cap + slot] = value;
+	}
+}
+
+template<class K, class V, class Hash> static inline
+usize map_alloc_size(usize cap){
+	return sizeof(MapEntry<K, V>) * cap + cap + MAP_GROUP_WIDTH;
+}
+
+template<class K, class V, class Hash> static inline
+usize map_alloc_align(){
+	return max<usize>(alignof(MapEntry<K, V>), MAP_GROUP_WIDTH);
+}
+
+/* Slot holding `key`, m->cap if absent */
+template<class K, class V, class Hash>
+usize map_find_slot(Map<K, V, Hash> const* m, K const& key, u64 hash){
+	if(m->len == 0){ return m->cap; }
+	usize mask = m->cap - 1;
+	u8 h2 = u8(hash >> 57);
+	usize pos = usize(hash) & mask;
+
+	for(;;){
+		u32 match = map_group_match(&m->ctrl[pos], h2);
+		u32 empty = map_group_match(&m->ctrl[pos], MAP_CTRL_EMPTY);
+		/* Entries never sit past an empty slot of their probe sequence */
+		if(empty){
+			match &= (empty & (0u - empty)) - 1;
+		}
+		while(match){
+			usize slot = (pos + usize(__builtin_ctz(match))) & mask;
+			if(m->entries[slot].key == key){ return slot; }
+			match &= match - 1;
+		}
+		if(empty){ return m->cap; }
+		pos = (pos + MAP_GROUP_WIDTH) & mask;
+	}
+}
+
+/* First empty slot of the probe sequence, the map must have at least one */
+template<class K, class V, class Hash>
+usize map_find_empty(Map<K, V, Hash> const* m, u64 hash){
+	usize mask = m->cap - 1;
+	usize pos = usize(hash) & mask;
+	for(;;){
+		u32 empty = map_group_match(&m->ctrl[pos], MAP_CTRL_EMPTY);
+		if(empty){
+			return (pos + usize(__builtin_ctz(empty))) & mask;
+		}
+		pos = (pos + MAP_GROUP_WIDTH) & mask;
+	}
+}
+
+// Resize to hold at least `count` entries without growing, returns false on allocation failure
+template<class K, class V, class Hash>
+bool map_reserve(Map<K, V, Hash>* m, usize count){
+	/* Maximum load factor of 7/8 */
+	usize cap = MAP_MIN_CAPACITY;
+	while(cap - cap / 8 < count){ cap *= 2; }
+	if(cap <= m->cap){ return true; }
+
+	void* block = mem_alloc_uninit(m->allocator, map_alloc_size<K, V, Hash>(cap), map_alloc_align<K, V, Hash>());
+	if(!block){ return false; }
+
+	Map<K, V, Hash> old = *m;
+	m->entries = (MapEntry<K, V>*)block;
+	m->ctrl = (u8*)&m->entries[cap];
+	m->cap = cap;
+	mem_set(m->ctrl, MAP_CTRL_EMPTY, cap + MAP_GROUP_WIDTH);
+
+	Hash hasher = {};
+	for(usize i = 0; i < old.cap; i += 1){
+		if(old.ctrl[i] == MAP_CTRL_EMPTY){ continue; }
+		u64 hash = hasher(old.entries[i].key);
+		usize slot = map_find_empty(m, hash);
+		map_set_ctrl(m, slot, u8(hash >> 57));
+		m->entries[slot] = old.entries[i];
+	}
+
+	if(old.entries){
+		mem_free(m->allocator, old.entries, map_alloc_size<K, V, Hash>(old.cap), map_alloc_align<K, V, Hash>());
+	}
+	return true;
+}
+
+template<class K, class V, class Hash = MapHash<K>>
+Map<K, V, Hash> make_map(Allocator a, usize count = 0){
+	Map<K, V, Hash> m = { nullptr, nullptr, 0, 0, a };
+	if(count){
+		map_reserve(&m, count);
+	}
+	return m;
+}
+
+template<class K, class V, class Hash>
+void map_destroy(Map<K, V, Hash>* m){
+	if(m->entries){
+		mem_free(m->allocator, m->entries, map_alloc_size<K, V, Hash>(m->cap), map_alloc_align<K, V, Hash>());
+	}
+	m->entries = nullptr;
+	m->ctrl = nullptr;
+	m->len = 0;
+	m->cap = 0;
+}
+
+template<class K, class V, class Hash>
+void map_clear(Map<K, V, Hash>* m){
+	if(m->ctrl){
+		mem_set(m->ctrl, MAP_CTRL_EMPTY, m->cap + MAP_GROUP_WIDTH);
+	}
+	m->len = 0;
+}
+
+// Pointer to the value of `key`, nullptr if absent. Invalidated by insertions and removals.
+template<class K, class V, class Hash>
+V* map_get(Map<K, V, Hash>* m, K const& key){
+	usize slot = map_find_slot(m, key, Hash{}(key));
+	return slot < m->cap ? &m->entries[slot].value : nullptr;
+}
+
+template<class K, class V, class Hash>
+V const* map_get(Map<K, V, Hash> const* m, K const& key){
+	usize slot = map_find_slot(m, key, Hash{}(key));
+	return slot < m->cap ? &m->entries[slot].value : nullptr;
+}
+
+template<class K, class V, class Hash>
+bool map_contains(Map<K, V, Hash> const* m, K const& key){
+	return map_get(m, key) != nullptr;
+}
+
+// Insert or overwrite, returns false if the table could not grow
+template<class K, class V, class Hash>
+bool map_set(Map<K, V, Hash>* m, K const& key, V const& value){
+	u64 hash = Hash{}(key);
+	usize slot = map_find_slot(m, key, hash);
+	if(slot < m->cap){
+		m->entries[slot].value = value;
+		return true;
+	}
+
+	/* Same 7/8 limit as map_reserve, checked here so inserting does not recompute the capacity */
+	if(m->len + 1 > m->cap - m->cap / 8 && !map_reserve(m, m->len + 1)){
+		return false;
+	}
+	slot = map_find_empty(m, hash);
+	map_set_ctrl(m, slot, u8(hash >> 57));
+	m->entries[slot] = MapEntry<K, V>{ key, value };
+	m->len += 1;
+	return true;
+}
+
+// Remove `key`, optionally returning its value. Returns false if it was absent.
+template<class K, class V, class Hash>
+bool map_remove(Map<K, V, Hash>* m, K const& key, V* value = nullptr){
+	Hash hasher = {};
+	usize hole = map_find_slot(m, key, hasher(key));
+	if(hole >= m->cap){ return false; }
+	if(value){ *value = m->entries[hole].value; }
+
+	/* Backward shift: pull every following entry of the run that may live in the hole */
+	usize mask = m->cap - 1;
+	for(usize i = (hole + 1) & mask; m->ctrl[i] != MAP_CTRL_EMPTY; i = (i + 1) & mask){
+		usize home = usize(hasher(m->entries[i].key)) & mask;
+		if(((i - home) & mask) >= ((i - hole) & mask)){
+			m->entries[hole] = m->entries[i];
+			map_set_ctrl(m, hole, m->ctrl[i]);
+			hole = i;
+		}
+	}
+	map_set_ctrl(m, hole, MAP_CTRL_EMPTY);
+	m->len -= 1;
+	return true;
+}
+
+//// Interner
+constexpr usize INTERN_SEGMENT_SHIFT = 8;
+constexpr usize INTERN_MAX_SEGMENTS = 24;
+constexpr usize INTERN_CHUNK_SIZE = 64 * 1024;
+
+// Handle to an interned string, two symbols from the same interner are equal exactly when their
+// strings are. The zero symbol is the empty string.
+struct Symbol {
+	u32 id;
+
+	bool operator==(Symbol s) const { return id == s.id; }
+
+	bool operator!=(Symbol s) const { return id != s.id; }
+};
+
+template<>
+struct MapHash<Symbol> {
+	u64 operator()(Symbol key) const { return hash_u64(key.id); }
+};
+
+struct InternEntry {
+	String str;
+	u64    hash;
+};
+
+// Open addressing table of (top 32 bits of hash, id) pairs, 0 is an empty slot. Replaced tables
+// are kept until the interner is destroyed because readers may still be probing them.
+struct InternTable {
+	u64*         slots;
+	usize        cap;
+	InternTable* prev;
+};
+
+struct InternChunk {
+	InternChunk* next;
+	usize        size;
+};
+
+// Deduplicates strings into chunks owned by the interner. Lookups of existing strings and symbol
+// resolution never take a lock, only inserting a new string does. Entries live in segments of
+// doubling size that are never moved, so an id stays valid while the table grows. Must not be
+// moved once shared between threads.
+struct Interner {
+	InternEntry*  segments[INTERN_MAX_SEGMENTS];
+	InternTable*  table;
+	u32           count;
+	Arena         strings;
+	InternChunk*  chunks;
+	Allocator     backing;
+	Spinlock      lock;
+};
+
+Interner interner_create(Allocator backing);
+
+// Release all memory, symbols and strings obtained from the interner become invalid
+void interner_destroy(Interner* in);
+
+// Symbol for `s`, copying it into the interner the first time it is seen. Interned strings are
+// also null terminated. Returns the zero symbol if memory could not be allocated. Thread safe.
+Symbol intern(Interner* in, String s);
+
+// Look up `s` without inserting it, returns false if it was never interned. Lock free.
+bool interner_find(Interner* in, String s, Symbol* sym);
+
+// String of a symbol, valid until the interner is destroyed. Lock free.
+String interner_get(Interner* in, Symbol sym);
+
+// Number of distinct non empty strings interned so far
+u32 interner_count(Interner* in);
@@ -2,10 +2,23 @@
 
 setlocal
 
+rem Usage: build.cmd [debug|release]
+set mode=%1
+if "%mode%"=="" set mode=debug
+
 set cc=clang++
-set cflags=-std=c++14 -fno-strict-aliasing -fwrapv -O0
+set cflags=-std=c++14 -fno-strict-aliasing -fwrapv
 set wflags=-Wall -Wextra -Werror=return-type -D_CRT_SECURE_NO_WARNINGS
 
+if "%mode%"=="debug" (
+	set cflags=%cflags% -O0 -g
+) else if "%mode%"=="release" (
+	set cflags=%cflags% -O2 -DBASE_NO_BOUNDS_CHECK
+) else (
+	echo Unknown build mode: %mode%
+	GOTO ERROR
+)
+
 echo [Code generation]
 %cc% %cflags% %wflags% generate.cpp base.cpp -o generate.exe
 if %ERRORLEVEL% NEQ 0 GOTO ERROR
@@ -14,12 +27,16 @@ generate.exe
 if %ERRORLEVEL% NEQ 0 GOTO ERROR
 
 echo [Compile]
-%cc% %cflags% %wflags% main.cpp base.cpp -o ft_sched.exe
+%cc% %cflags% %wflags% main.cpp base.cpp ft_sched.cpp config_ini.cpp -o ft_sched.exe
 if %ERRORLEVEL% NEQ 0 GOTO ERROR
 
 ft_sched.exe
 if %ERRORLEVEL% NEQ 0 GOTO ERROR
 
+echo [Benchmarks]
+%cc% %cflags% %wflags% -O2 bench.cpp base.cpp ft_sched.cpp config_ini.cpp -o bench.exe
+if %ERRORLEVEL% NEQ 0 GOTO ERROR
+
 rem --------------------------------------------
 :SUCCESS
 exit /b 0
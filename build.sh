@@ -1,13 +1,30 @@
 #!/usr/bin/env sh
 
-cc=clang++
-cflags='-std=c++14 -fno-strict-aliasing -fwrapv -O0'
+# Usage: build.sh [debug|release]
+mode=${1:-debug}
+
+cc=${CXX:-clang++}
+cflags='-std=c++14 -fno-strict-aliasing -fwrapv -pthread'
 wflags='-Wall -Wextra -Werror=return-type'
 
 Run(){ echo "$@"; $@; }
 
 set -eu
 
+case "$mode" in
+	debug)   cflags="$cflags -O0 -g" ;;
+	release) cflags="$cflags -O2 -DBASE_NO_BOUNDS_CHECK" ;;
+	*) echo "Unknown build mode: $mode"; exit 1 ;;
+esac
+
 cflags="$cflags $wflags"
 
-Run $cc $cflags $wflags main.cpp -o ft_sched.exe
+echo '[Code generation]'
+Run $cc $cflags generate.cpp base.cpp -o generate.exe
+Run ./generate.exe
+
+echo '[Compile]'
+Run $cc $cflags main.cpp base.cpp ft_sched.cpp config_ini.cpp -o ft_sched.exe
+
+echo '[Benchmarks]'
+Run $cc $cflags -O2 bench.cpp base.cpp ft_sched.cpp config_ini.cpp -o bench.exe
@@ -1,51 +1,554 @@
-#include "base.hpp"
+#include "config_ini.hpp"
 
-struct INI_Document {
-	INI_Section* first_section;
-	INI_Section* last_section;
-};
-
-struct INI_Section {
-	String name;
-	INI_Entry* first_entry;
-	INI_Entry* last_entry;
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
-	INI_Section* next;
-};
+constexpr usize INI_BLOCK_SIZE = 64;
+/* Holds the source and its parsed document, address space is cheap */
+constexpr usize INI_SNAPSHOT_RESERVE = 1024LL * 1024LL * 1024LL;
 
-struct INI_Entry {
-	String key;
-	String value;
-	INI_Entry* next;
+/* Which bytes ini_find stops at, the newline is always included so scans never leave the line */
+enum INI_Stop : u8 {
+	INI_Stop_Newline = 0,
+	INI_Stop_Equals  = 1,
+	INI_Stop_Close   = 2,
 };
 
+/* The source is classified 64 bytes at a time into one bitmask per stop set, lines are then found
+ * with a count of trailing zeros instead of a byte loop. Every scan moves forward, so each block is
+ * classified once. */
 struct INI_Parser {
 	String source;
 	usize current;
+	u32 line;
 	Arena* arena;
+	INI_Document* doc;
+	INI_Error* error;
+
+	INI_Section* section;
+	INI_Entry* unindexed; /* First entry of `section` not yet in its map */
+	usize unindexed_count;
+
+	usize block;
+	u64 masks[3];
 };
 
-void ini_skip_whitespace(INI_Parser* parser){
-	constexpr auto is_whitespace = [](rune c) -> bool {
-		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
-	};
+static inline
+bool ini_is_space(u8 c){
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static
+String ini_trim(char const* begin, char const* end){
+	while(begin < end && ini_is_space(u8(*begin))){ begin += 1; }
+	while(end > begin && ini_is_space(u8(end[-1]))){ end -= 1; }
+	return String(begin, usize(end - begin));
+}
 
-	for(; parser->current < source.len; parser->current += 1){
-		if(!is_whitespace(parser->source[parser->current])){
+static
+bool ini_fail(INI_Parser* p, cstring message){
+	if(p->error){
+		p->error->message = message;
+		p->error->line = p->line;
+	}
+	return false;
+}
+
+__attribute__((noinline)) static
+void ini_classify_block(INI_Parser* p, usize block){
+	u8 const* src = (u8 const*)p->source.data + block;
+	/* The tail is copied so the loads below never read past the source */
+	u8 tail[INI_BLOCK_SIZE];
+	if(p->source.len - block < INI_BLOCK_SIZE){
+		mem_zero(tail, INI_BLOCK_SIZE);
+		mem_copy(tail, src, p->source.len - block);
+		src = tail;
+	}
+
+	u64 newline = 0, equals = 0, close = 0;
+#if defined(__SSE2__)
+	for(usize i = 0; i < INI_BLOCK_SIZE; i += 16){
+		__m128i v = _mm_loadu_si128((__m128i const*)(src + i));
+		newline |= u64(u32(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))))) << i;
+		equals  |= u64(u32(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('='))))) << i;
+		close   |= u64(u32(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(']'))))) << i;
+	}
+#else
+	for(usize i = 0; i < INI_BLOCK_SIZE; i += 1){
+		newline |= u64(src[i] == '\n') << i;
+		equals  |= u64(src[i] == '=') << i;
+		close   |= u64(src[i] == ']') << i;
+	}
+#endif
+
+	p->block = block;
+	p->masks[INI_Stop_Newline] = newline;
+	p->masks[INI_Stop_Equals]  = newline | equals;
+	p->masks[INI_Stop_Close]   = newline | close;
+}
+
+/* Offset of the first stop byte at or after `from`, the source length if there is none */
+static inline
+usize ini_find(INI_Parser* p, usize from, INI_Stop stop){
+	while(from < p->source.len){
+		usize block = from & ~(INI_BLOCK_SIZE - 1);
+		if(block != p->block){
+			ini_classify_block(p, block);
+		}
+		u64 bits = p->masks[stop] >> (from - block);
+		if(bits){
+			return min(from + usize(__builtin_ctzll(bits)), p->source.len);
+		}
+		from = block + INI_BLOCK_SIZE;
+	}
+	return p->source.len;
+}
+
+/* Skips blank lines too, this is the only place that advances past a newline */
+static
+void ini_skip_whitespace(INI_Parser* p){
+	for(; p->current < p->source.len; p->current += 1){
+		u8 c = u8(p->source.data[p->current]);
+		if(c == '\n'){
+			p->line += 1;
+		}
+		else if(!ini_is_space(c)){
 			break;
 		}
 	}
 }
 
+static
 void ini_consume_comment(INI_Parser* p){
-	for(; parser->current < source.len; parser->current += 1){
-		if(parser->source[parser->current] == '\n'){
-			break;
+	p->current = ini_find(p, p->current, INI_Stop_Newline);
+}
+
+/* Entries are added to the section's map once the section ends, so it is sized exactly once */
+static
+bool ini_index_section(INI_Parser* p){
+	INI_Section* section = p->section;
+	if(!section || !p->unindexed_count){ return true; }
+
+	if(!map_reserve(&section->entries, section->entries.len + p->unindexed_count)){ return false; }
+	for(INI_Entry* entry = p->unindexed; entry; entry = entry->next){
+		map_set(&section->entries, entry->key, entry);
+	}
+	p->unindexed = nullptr;
+	p->unindexed_count = 0;
+	return true;
+}
+
+static
+INI_Section* ini_open_section(INI_Parser* p, String name){
+	if(!ini_index_section(p)){ return nullptr; }
+
+	INI_Document* doc = p->doc;
+	if(INI_Section** found = map_get(&doc->sections, name)){
+		return *found;
+	}
+
+	auto section = make<INI_Section>(p->arena);
+	if(!section){ return nullptr; }
+	section->name = name;
+	section->entries = make_map<String, INI_Entry*>(arena_allocator(p->arena));
+	if(!map_set(&doc->sections, name, section)){ return nullptr; }
+
+	if(doc->last_section){
+		doc->last_section->next = section;
+	}
+	else {
+		doc->first_section = section;
+	}
+	doc->last_section = section;
+	return section;
+}
+
+static
+bool ini_consume_section(INI_Parser* p){
+	ensure(p->source.data[p->current] == '[', "Section header must start with '['");
+	char const* data = p->source.data;
+
+	usize close = ini_find(p, p->current, INI_Stop_Close);
+	if(close == p->source.len || data[close] != ']'){
+		return ini_fail(p, "Unterminated section header");
+	}
+
+	usize eol = ini_find(p, close, INI_Stop_Newline);
+	String rest = ini_trim(data + close + 1, data + eol);
+	if(rest.len > 0 && rest.data[0] != ';' && rest.data[0] != '#'){
+		return ini_fail(p, "Unexpected characters after section header");
+	}
+
+	p->section = ini_open_section(p, ini_trim(data + p->current + 1, data + close));
+	if(!p->section){
+		return ini_fail(p, "Out of memory");
+	}
+	p->current = eol;
+	return true;
+}
+
+static
+bool ini_consume_entry(INI_Parser* p){
+	char const* data = p->source.data;
+
+	usize eq = ini_find(p, p->current, INI_Stop_Equals);
+	if(eq == p->source.len || data[eq] != '='){
+		return ini_fail(p, "Expected '=' after key");
+	}
+
+	String key = ini_trim(data + p->current, data + eq);
+	if(key.len == 0){
+		return ini_fail(p, "Empty key");
+	}
+
+	if(!p->section){
+		p->section = ini_open_section(p, String());
+		if(!p->section){
+			return ini_fail(p, "Out of memory");
 		}
 	}
+
+	auto entry = (INI_Entry*)arena_alloc_uninit(p->arena, sizeof(INI_Entry), alignof(INI_Entry));
+	if(!entry){
+		return ini_fail(p, "Out of memory");
+	}
+	usize eol = ini_find(p, eq, INI_Stop_Newline);
+	entry->key = key;
+	entry->value = ini_trim(data + eq + 1, data + eol);
+	entry->next = nullptr;
+
+	INI_Section* section = p->section;
+	if(section->last_entry){
+		section->last_entry->next = entry;
+	}
+	else {
+		section->first_entry = entry;
+	}
+	section->last_entry = entry;
+
+	if(!p->unindexed){
+		p->unindexed = entry;
+	}
+	p->unindexed_count += 1;
+
+	p->current = eol;
+	return true;
+}
+
+bool ini_parse(String source, Arena* arena, INI_Document* doc, INI_Error* error){
+	mem_zero(doc, sizeof(*doc));
+	doc->sections = make_map<String, INI_Section*>(arena_allocator(arena));
+
+	INI_Parser parser = {};
+	INI_Parser* p = &parser;
+	p->source = source;
+	p->line = 1;
+	p->arena = arena;
+	p->doc = doc;
+	p->error = error;
+	p->block = ~usize(0);
+
+	for(;;){
+		ini_skip_whitespace(p);
+		if(p->current >= source.len){ break; }
+
+		u8 c = u8(source.data[p->current]);
+		bool ok = true;
+		if(c == ';' || c == '#'){
+			ini_consume_comment(p);
+		}
+		else if(c == '['){
+			ok = ini_consume_section(p);
+		}
+		else {
+			ok = ini_consume_entry(p);
+		}
+		if(!ok){ return false; }
+	}
+
+	if(!ini_index_section(p)){
+		return ini_fail(p, "Out of memory");
+	}
+	return true;
+}
+
+INI_Section* ini_find_section(INI_Document const* doc, String name){
+	INI_Section* const* found = map_get(&doc->sections, name);
+	return found ? *found : nullptr;
 }
 
-INI_Section ini_consume_section(INI_Parser* p){
-	assert(p->source[p->current] == '[', "");
+INI_Entry* ini_find_entry(INI_Section const* section, String key){
+	INI_Entry* const* found = map_get(&section->entries, key);
+	return found ? *found : nullptr;
 }
 
+String ini_get(INI_Document const* doc, String section, String key, String fallback){
+	INI_Section* s = ini_find_section(doc, section);
+	INI_Entry* e = s ? ini_find_entry(s, key) : nullptr;
+	return e ? e->value : fallback;
+}
+
+//// Hot reload
+static
+void ini_snapshot_destroy(INI_Snapshot* s){
+	/* The snapshot lives in its own arena */
+	Arena arena = s->arena;
+	arena_destroy(&arena);
+}
+
+/* Read into the snapshot's arena rather than mapped, a file rewritten in place would otherwise
+ * change or fault under readers still holding an older snapshot */
+static
+INI_Snapshot* ini_snapshot_load(cstring path, INI_Error* error){
+	Arena arena = arena_create_virtual(INI_SNAPSHOT_RESERVE);
+	auto snapshot = make<INI_Snapshot>(&arena);
+	if(!snapshot){
+		*error = INI_Error{ "Out of memory", 0 };
+		arena_destroy(&arena);
+		return nullptr;
+	}
+
+	auto source = file_read(path, &arena);
+	if(!source.data){
+		*error = INI_Error{ "Failed to read file", 0 };
+		arena_destroy(&arena);
+		return nullptr;
+	}
+
+	/* From here on the arena is only used through the snapshot */
+	snapshot->arena = arena;
+	if(!ini_parse(String(source), &snapshot->arena, &snapshot->doc, error)){
+		ini_snapshot_destroy(snapshot);
+		return nullptr;
+	}
+	return snapshot;
+}
+
+static
+bool ini_section_equal(INI_Section const* a, INI_Section const* b){
+	if(a->entries.len != b->entries.len){ return false; }
+	for(auto const& e : b->entries){
+		INI_Entry* other = ini_find_entry(a, e.key);
+		if(!other || other->value != e.value->value){ return false; }
+	}
+	return true;
+}
+
+/* Sections of `next` in document order, then the ones only `prev` has */
+static
+bool ini_diff(INI_Document const* prev, INI_Document const* next, List<INI_Change>* changes){
+	for(INI_Section const* section = next->first_section; section; section = section->next){
+		INI_Section const* old = ini_find_section(prev, section->name);
+		if(!old){
+			if(!append(changes, INI_Change{ INI_Change_Added, section->name, nullptr, section })){ return false; }
+		}
+		else if(!ini_section_equal(old, section)){
+			if(!append(changes, INI_Change{ INI_Change_Modified, section->name, old, section })){ return false; }
+		}
+	}
+	for(INI_Section const* section = prev->first_section; section; section = section->next){
+		if(!ini_find_section(next, section->name)){
+			if(!append(changes, INI_Change{ INI_Change_Removed, section->name, section, nullptr })){ return false; }
+		}
+	}
+	return true;
+}
+
+/* A reader counts itself in `acquiring` before loading `current` and leaves only after counting
+ * itself in the snapshot, all sequentially consistent. A snapshot retired before `acquiring` was
+ * seen at zero can therefore not gain readers anymore, it is freed once its own count drops to
+ * zero. The gate is held for a few instructions, unlike the snapshot itself. */
+static
+void ini_watcher_collect(INI_Watcher* w){
+	if(!w->retired){ return; }
+
+	if(atomic_load(&w->acquiring) == 0){
+		for(INI_Snapshot* s = w->retired; s; s = s->retired_next){
+			s->drained = true;
+		}
+	}
+
+	INI_Snapshot** link = &w->retired;
+	while(*link){
+		INI_Snapshot* s = *link;
+		if(s->drained && atomic_load(&s->readers) == 0){
+			*link = s->retired_next;
+			ini_snapshot_destroy(s);
+		}
+		else {
+			link = &s->retired_next;
+		}
+	}
+}
+
+INI_Watcher* ini_watcher_create(String path, Allocator allocator, INI_Error* error){
+	INI_Error local_error = {};
+	if(!error){ error = &local_error; }
+
+	auto w = make<INI_Watcher>(allocator);
+	auto path_buf = make_slice_uninit<char>(allocator, path.len + 1);
+	if(!w || !path_buf.data){
+		*error = INI_Error{ "Out of memory", 0 };
+		mem_free(allocator, path_buf.data, path_buf.len, 1);
+		mem_free(allocator, w, sizeof(INI_Watcher), alignof(INI_Watcher));
+		return nullptr;
+	}
+	mem_copy_no_overlap(path_buf.data, path.data, path.len);
+	path_buf[path.len] = 0;
+
+	isize slash = last_index_byte(path, '/');
+	w->allocator = allocator;
+	w->path = path_buf.data;
+	w->name = skip(String(path_buf.data, path.len), usize(slash + 1));
+	w->subscribers = make_list<INI_Subscriber>(allocator);
+	w->notify_fd = -1;
+
+	w->current = ini_snapshot_load(w->path, error);
+	if(!w->current){
+		ini_watcher_destroy(w);
+		return nullptr;
+	}
+	w->current->version = 1;
+
+#if defined(__linux__)
+	/* Watch the directory, generators and editors usually replace the file instead of writing it */
+	auto dir = make_slice_uninit<char>(allocator, path.len + 2);
+	if(!dir.data){
+		*error = INI_Error{ "Out of memory", 0 };
+		ini_watcher_destroy(w);
+		return nullptr;
+	}
+	if(slash < 0){
+		mem_copy_no_overlap(dir.data, ".", 2);
+	}
+	else {
+		usize dir_len = slash == 0 ? 1 : usize(slash);
+		mem_copy_no_overlap(dir.data, path.data, dir_len);
+		dir[dir_len] = 0;
+	}
+
+	w->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	bool watching = w->notify_fd >= 0 && inotify_add_watch(w->notify_fd, dir.data, IN_CLOSE_WRITE | IN_MOVED_TO) >= 0;
+	mem_free(allocator, dir.data, dir.len, 1);
+	if(!watching){
+		*error = INI_Error{ "Failed to watch directory", 0 };
+		ini_watcher_destroy(w);
+		return nullptr;
+	}
+#endif
+
+	return w;
+}
+
+void ini_watcher_destroy(INI_Watcher* w){
+	if(!w){ return; }
+	bool released = !w->current || atomic_load(&w->current->readers) == 0;
+	for(INI_Snapshot* s = w->retired; s; s = s->retired_next){
+		released = released && atomic_load(&s->readers) == 0;
+	}
+	ensure(released, "Snapshots must be released before destroying the watcher");
+
+#if defined(__linux__)
+	if(w->notify_fd >= 0){
+		close(w->notify_fd);
+	}
+#endif
+
+	while(w->retired){
+		INI_Snapshot* next = w->retired->retired_next;
+		ini_snapshot_destroy(w->retired);
+		w->retired = next;
+	}
+	if(w->current){
+		ini_snapshot_destroy(w->current);
+	}
+	destroy(&w->subscribers);
+	mem_free(w->allocator, (void*)w->path, cstring_len(w->path) + 1, 1);
+	mem_free(w->allocator, w, sizeof(INI_Watcher), alignof(INI_Watcher));
+}
+
+bool ini_watcher_subscribe(INI_Watcher* w, INI_ReloadProc proc, void* user){
+	return append(&w->subscribers, INI_Subscriber{ proc, user });
+}
+
+INI_Reload ini_watcher_reload(INI_Watcher* w){
+	ini_watcher_collect(w);
+
+	INI_Snapshot* next = ini_snapshot_load(w->path, &w->error);
+	if(!next){ return INI_Reload_Failed; }
+
+	/* Only this thread replaces `current` */
+	INI_Snapshot* prev = atomic_load(&w->current, MemoryOrder_Relaxed);
+	auto changes = make_list<INI_Change>(arena_allocator(&next->arena));
+	if(!ini_diff(&prev->doc, &next->doc, &changes)){
+		w->error = INI_Error{ "Out of memory", 0 };
+		ini_snapshot_destroy(next);
+		return INI_Reload_Failed;
+	}
+	if(changes.len == 0){
+		ini_snapshot_destroy(next);
+		return INI_Reload_None;
+	}
+
+	next->version = prev->version + 1;
+	atomic_store(&w->current, next);
+
+	for(INI_Subscriber const& sub : w->subscribers){
+		sub.proc(sub.user, next, Slice<INI_Change>{ changes.data, changes.len });
+	}
+
+	prev->retired_next = w->retired;
+	w->retired = prev;
+	ini_watcher_collect(w);
+	return INI_Reload_Applied;
+}
+
+INI_Reload ini_watcher_poll(INI_Watcher* w, i32 timeout_ms){
+	ini_watcher_collect(w);
+
+#if defined(__linux__)
+	pollfd pfd = { w->notify_fd, POLLIN, 0 };
+	if(poll(&pfd, 1, timeout_ms) <= 0){ return INI_Reload_None; }
+
+	/* Drain every pending event, a burst of writes results in a single reload */
+	bool changed = false;
+	alignas(inotify_event) char buf[4096];
+	for(;;){
+		isize n = read(w->notify_fd, buf, sizeof(buf));
+		if(n <= 0){ break; }
+		for(isize i = 0; i < n; ){
+			auto event = (inotify_event const*)(buf + i);
+			if(event->mask & IN_Q_OVERFLOW){
+				changed = true;
+			}
+			else if(event->len > 0 && String(event->name) == w->name){
+				changed = true;
+			}
+			i += isize(sizeof(inotify_event) + event->len);
+		}
+	}
+
+	return changed ? ini_watcher_reload(w) : INI_Reload_None;
+#else
+	(void)timeout_ms;
+	return INI_Reload_None;
+#endif
+}
+
+INI_Snapshot const* ini_watcher_acquire(INI_Watcher* w){
+	atomic_add(&w->acquiring, i64(1));
+	INI_Snapshot* snapshot = atomic_load(&w->current);
+	atomic_add(&snapshot->readers, i64(1));
+	atomic_sub(&w->acquiring, i64(1));
+	return snapshot;
+}
+
+void ini_watcher_release(INI_Watcher* w, INI_Snapshot const* snapshot){
+	(void)w;
+	ensure(snapshot, "Releasing a null snapshot");
+	/* The count is the only part of a snapshot readers write to */
+	atomic_sub(&((INI_Snapshot*)snapshot)->readers, i64(1));
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include "base.hpp"
+
+//// INI
+// Names, keys and values are views into the parsed source, which must outlive the document.
+// Everything else lives in the arena given to ini_parse.
+struct INI_Entry {
+	String key;
+	String value;
+	INI_Entry* next;
+};
+
+struct INI_Section {
+	String name;
+	INI_Entry* first_entry;
+	INI_Entry* last_entry;
+	Map<String, INI_Entry*> entries;
+
+	INI_Section* next;
+};
+
+struct INI_Document {
+	INI_Section* first_section;
+	INI_Section* last_section;
+	Map<String, INI_Section*> sections;
+};
+
+struct INI_Error {
+	cstring message;
+	u32 line;
+};
+
+// Parse `source` in a single pass. Whitespace around names, keys and values is trimmed, lines
+// starting with ';' or '#' are comments and entries before the first header go in a section with
+// an empty name. Repeated sections are merged, a repeated key keeps its entries in order but
+// lookups return the last one. On failure returns false and fills `error` if it is not null, the
+// arena keeps whatever was allocated until then.
+bool ini_parse(String source, Arena* arena, INI_Document* doc, INI_Error* error = nullptr);
+
+// Section named `name`, nullptr if absent
+INI_Section* ini_find_section(INI_Document const* doc, String name);
+
+// Last entry with `key` in the section, nullptr if absent
+INI_Entry* ini_find_entry(INI_Section const* section, String key);
+
+// Value of `key` in `section`, `fallback` if either is absent
+String ini_get(INI_Document const* doc, String section, String key, String fallback = String());
+
+//// Hot reload
+enum INI_ChangeKind : u8 {
+	INI_Change_Added,
+	INI_Change_Removed,
+	INI_Change_Modified,
+};
+
+// A section whose keys or values differ between two documents. `old_section` is null for added
+// sections and `new_section` for removed ones.
+struct INI_Change {
+	INI_ChangeKind kind;
+	String name;
+	INI_Section const* old_section;
+	INI_Section const* new_section;
+};
+
+// A parsed version of the watched file. The document, its source and everything it points to
+// live in `arena`, which is released once the snapshot is replaced and its own readers are gone.
+struct INI_Snapshot {
+	INI_Document doc;
+	Arena arena;
+	u64 version;
+	i64 readers; /* Acquired and not yet released */
+
+	bool drained; /* Retired and no reader can still be about to acquire it */
+	INI_Snapshot* retired_next;
+};
+
+// Called after a new snapshot was published, with the sections that differ from the previous
+// one. Pointers into the previous snapshot are only valid during the call.
+using INI_ReloadProc = void (*)(void* user, INI_Snapshot const* snapshot, Slice<INI_Change> changes);
+
+struct INI_Subscriber {
+	INI_ReloadProc proc;
+	void* user;
+};
+
+enum INI_Reload : u8 {
+	INI_Reload_None,
+	INI_Reload_Applied,
+	INI_Reload_Failed,
+};
+
+// Readers only touch `current`, `acquiring` and the reader count of their snapshot. Reloading
+// happens on the thread calling ini_watcher_poll, one at a time.
+struct INI_Watcher {
+	INI_Snapshot* current;
+	i64 acquiring; /* Readers between loading `current` and counting themselves in it */
+
+	INI_Snapshot* retired;
+	List<INI_Subscriber> subscribers;
+	cstring path;
+	String name; /* File name inside the watched directory */
+	i32 notify_fd;
+	INI_Error error;
+	Allocator allocator;
+};
+
+// Load and parse `path`, then watch its directory so replacing the file by a rename is noticed too.
+// Change notifications use inotify and are only delivered on Linux, elsewhere ini_watcher_reload
+// has to be called explicitly. Returns nullptr if the file cannot be read or parsed, filling
+// `error` if it is not null.
+INI_Watcher* ini_watcher_create(String path, Allocator allocator, INI_Error* error = nullptr);
+
+// Every snapshot must have been released before calling this
+void ini_watcher_destroy(INI_Watcher* w);
+
+// Not thread safe, subscribe before polling starts
+bool ini_watcher_subscribe(INI_Watcher* w, INI_ReloadProc proc, void* user);
+
+// Wait up to `timeout_ms` (-1 blocks, 0 returns immediately) for the file to change and reload it.
+// On failure the current snapshot is kept and the reason is in `w->error`.
+INI_Reload ini_watcher_poll(INI_Watcher* w, i32 timeout_ms);
+
+// Re-read and parse the file unconditionally, notifying subscribers if any section changed
+INI_Reload ini_watcher_reload(INI_Watcher* w);
+
+// Current snapshot, never blocks. It stays valid until the matching ini_watcher_release, holding
+// it only keeps that snapshot alive and never stalls reloading or freeing the others.
+INI_Snapshot const* ini_watcher_acquire(INI_Watcher* w);
+
+void ini_watcher_release(INI_Watcher* w, INI_Snapshot const* snapshot);
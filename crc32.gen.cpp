@@ -33,16 +33,923 @@ constexpr u32 crc32_lut[] = {
 	0x871b1fa0,0x6aa39c80,0xb1d29ac0,0x5c6a19e0,0xea881560,0x7309640,0xdc419000,0x31f91320,
 	0x5c3d0a20,0xb1858900,0x6af48f40,0x874c0c60,0x31ae00e0,0xdc1683c0,0x7678580,0xeadf06a0,
 };
+constexpr u32 crc32_lut_sliced[16][256] = {
+	{
+		0x0000,0xedb88320,0x36c98560,0xdb710640,0x6d930ac0,0x802b89e0,0x5b5a8fa0,0xb6e20c80,
+		0xdb261580,0x369e96a0,0xedef90e0,0x5713c0,0xb6b51f40,0x5b0d9c60,0x807c9a20,0x6dc41900,
+		0x5bf4a820,0xb64c2b00,0x6d3d2d40,0x8085ae60,0x3667a2e0,0xdbdf21c0,0xae2780,0xed16a4a0,
+		0x80d2bda0,0x6d6a3e80,0xb61b38c0,0x5ba3bbe0,0xed41b760,0xf93440,0xdb883200,0x3630b120,
+		0xb7e95040,0x5a51d360,0x8120d520,0x6c985600,0xda7a5a80,0x37c2d9a0,0xecb3dfe0,0x10b5cc0,
+		0x6ccf45c0,0x8177c6e0,0x5a06c0a0,0xb7be4380,0x15c4f00,0xece4cc20,0x3795ca60,0xda2d4940,
+		0xec1df860,0x1a57b40,0xdad47d00,0x376cfe20,0x818ef2a0,0x6c367180,0xb74777c0,0x5afff4e0,
+		0x373bede0,0xda836ec0,0x1f26880,0xec4aeba0,0x5aa8e720,0xb7106400,0x6c616240,0x81d9e160,
+		0x826a23a0,0x6fd2a080,0xb4a3a6c0,0x591b25e0,0xeff92960,0x241aa40,0xd930ac00,0x34882f20,
+		0x594c3620,0xb4f4b500,0x6f85b340,0x823d3060,0x34df3ce0,0xd967bfc0,0x216b980,0xefae3aa0,
+		0xd99e8b80,0x342608a0,0xef570ee0,0x2ef8dc0,0xb40d8140,0x59b50260,0x82c40420,0x6f7c8700,
+		0x2b89e00,0xef001d20,0x34711b60,0xd9c99840,0x6f2b94c0,0x829317e0,0x59e211a0,0xb45a9280,
+		0x358373e0,0xd83bf0c0,0x34af680,0xeef275a0,0x58107920,0xb5a8fa00,0x6ed9fc40,0x83617f60,
+		0xeea56660,0x31de540,0xd86ce300,0x35d46020,0x83366ca0,0x6e8eef80,0xb5ffe9c0,0x58476ae0,
+		0x6e77dbc0,0x83cf58e0,0x58be5ea0,0xb506dd80,0x3e4d100,0xee5c5220,0x352d5460,0xd895d740,
+		0xb551ce40,0x58e94d60,0x83984b20,0x6e20c800,0xd8c2c480,0x357a47a0,0xee0b41e0,0x3b3c2c0,
+		0xe96cc460,0x4d44740,0xdfa54100,0x321dc220,0x84ffcea0,0x69474d80,0xb2364bc0,0x5f8ec8e0,
+		0x324ad1e0,0xdff252c0,0x4835480,0xe93bd7a0,0x5fd9db20,0xb2615800,0x69105e40,0x84a8dd60,
+		0xb2986c40,0x5f20ef60,0x8451e920,0x69e96a00,0xdf0b6680,0x32b3e5a0,0xe9c2e3e0,0x47a60c0,
+		0x69be79c0,0x8406fae0,0x5f77fca0,0xb2cf7f80,0x42d7300,0xe995f020,0x32e4f660,0xdf5c7540,
+		0x5e859420,0xb33d1700,0x684c1140,0x85f49260,0x33169ee0,0xdeae1dc0,0x5df1b80,0xe86798a0,
+		0x85a381a0,0x681b0280,0xb36a04c0,0x5ed287e0,0xe8308b60,0x5880840,0xdef90e00,0x33418d20,
+		0x5713c00,0xe8c9bf20,0x33b8b960,0xde003a40,0x68e236c0,0x855ab5e0,0x5e2bb3a0,0xb3933080,
+		0xde572980,0x33efaaa0,0xe89eace0,0x5262fc0,0xb3c42340,0x5e7ca060,0x850da620,0x68b52500,
+		0x6b06e7c0,0x86be64e0,0x5dcf62a0,0xb077e180,0x695ed00,0xeb2d6e20,0x305c6860,0xdde4eb40,
+		0xb020f240,0x5d987160,0x86e97720,0x6b51f400,0xddb3f880,0x300b7ba0,0xeb7a7de0,0x6c2fec0,
+		0x30f24fe0,0xdd4accc0,0x63bca80,0xeb8349a0,0x5d614520,0xb0d9c600,0x6ba8c040,0x86104360,
+		0xebd45a60,0x66cd940,0xdd1ddf00,0x30a55c20,0x864750a0,0x6bffd380,0xb08ed5c0,0x5d3656e0,
+		0xdcefb780,0x315734a0,0xea2632e0,0x79eb1c0,0xb17cbd40,0x5cc43e60,0x87b53820,0x6a0dbb00,
+		0x7c9a200,0xea712120,0x31002760,0xdcb8a440,0x6a5aa8c0,0x87e22be0,0x5c932da0,0xb12bae80,
+		0x871b1fa0,0x6aa39c80,0xb1d29ac0,0x5c6a19e0,0xea881560,0x7309640,0xdc419000,0x31f91320,
+		0x5c3d0a20,0xb1858900,0x6af48f40,0x874c0c60,0x31ae00e0,0xdc1683c0,0x7678580,0xeadf06a0,
+	},
+	{
+		0x0000,0x3f610be0,0x7ec217c0,0x41a31c20,0xfd842f80,0xc2e52460,0x83463840,0xbc2733a0,
+		0x16b0dc20,0x29d1d7c0,0x6872cbe0,0x5713c000,0xeb34f3a0,0xd455f840,0x95f6e460,0xaa97ef80,
+		0x2d61b840,0x1200b3a0,0x53a3af80,0x6cc2a460,0xd0e597c0,0xef849c20,0xae278000,0x91468be0,
+		0x3bd16460,0x4b06f80,0x451373a0,0x7a727840,0xc6554be0,0xf9344000,0xb8975c20,0x87f657c0,
+		0x5ac37080,0x65a27b60,0x24016740,0x1b606ca0,0xa7475f00,0x982654e0,0xd98548c0,0xe6e44320,
+		0x4c73aca0,0x7312a740,0x32b1bb60,0xdd0b080,0xb1f78320,0x8e9688c0,0xcf3594e0,0xf0549f00,
+		0x77a2c8c0,0x48c3c320,0x960df00,0x3601d4e0,0x8a26e740,0xb547eca0,0xf4e4f080,0xcb85fb60,
+		0x611214e0,0x5e731f00,0x1fd00320,0x20b108c0,0x9c963b60,0xa3f73080,0xe2542ca0,0xdd352740,
+		0xb586e100,0x8ae7eae0,0xcb44f6c0,0xf425fd20,0x4802ce80,0x7763c560,0x36c0d940,0x9a1d2a0,
+		0xa3363d20,0x9c5736c0,0xddf42ae0,0xe2952100,0x5eb212a0,0x61d31940,0x20700560,0x1f110e80,
+		0x98e75940,0xa78652a0,0xe6254e80,0xd9444560,0x656376c0,0x5a027d20,0x1ba16100,0x24c06ae0,
+		0x8e578560,0xb1368e80,0xf09592a0,0xcff49940,0x73d3aae0,0x4cb2a100,0xd11bd20,0x3270b6c0,
+		0xef459180,0xd0249a60,0x91878640,0xaee68da0,0x12c1be00,0x2da0b5e0,0x6c03a9c0,0x5362a220,
+		0xf9f54da0,0xc6944640,0x87375a60,0xb8565180,0x4716220,0x3b1069c0,0x7ab375e0,0x45d27e00,
+		0xc22429c0,0xfd452220,0xbce63e00,0x838735e0,0x3fa00640,0xc10da0,0x41621180,0x7e031a60,
+		0xd494f5e0,0xebf5fe00,0xaa56e220,0x9537e9c0,0x2910da60,0x1671d180,0x57d2cda0,0x68b3c640,
+		0x86b54120,0xb9d44ac0,0xf87756e0,0xc7165d00,0x7b316ea0,0x44506540,0x5f37960,0x3a927280,
+		0x90059d00,0xaf6496e0,0xeec78ac0,0xd1a68120,0x6d81b280,0x52e0b960,0x1343a540,0x2c22aea0,
+		0xabd4f960,0x94b5f280,0xd516eea0,0xea77e540,0x5650d6e0,0x6931dd00,0x2892c120,0x17f3cac0,
+		0xbd642540,0x82052ea0,0xc3a63280,0xfcc73960,0x40e00ac0,0x7f810120,0x3e221d00,0x14316e0,
+		0xdc7631a0,0xe3173a40,0xa2b42660,0x9dd52d80,0x21f21e20,0x1e9315c0,0x5f3009e0,0x60510200,
+		0xcac6ed80,0xf5a7e660,0xb404fa40,0x8b65f1a0,0x3742c200,0x823c9e0,0x4980d5c0,0x76e1de20,
+		0xf11789e0,0xce768200,0x8fd59e20,0xb0b495c0,0xc93a660,0x33f2ad80,0x7251b1a0,0x4d30ba40,
+		0xe7a755c0,0xd8c65e20,0x99654200,0xa60449e0,0x1a237a40,0x254271a0,0x64e16d80,0x5b806660,
+		0x3333a020,0xc52abc0,0x4df1b7e0,0x7290bc00,0xceb78fa0,0xf1d68440,0xb0759860,0x8f149380,
+		0x25837c00,0x1ae277e0,0x5b416bc0,0x64206020,0xd8075380,0xe7665860,0xa6c54440,0x99a44fa0,
+		0x1e521860,0x21331380,0x60900fa0,0x5ff10440,0xe3d637e0,0xdcb73c00,0x9d142020,0xa2752bc0,
+		0x8e2c440,0x3783cfa0,0x7620d380,0x4941d860,0xf566ebc0,0xca07e020,0x8ba4fc00,0xb4c5f7e0,
+		0x69f0d0a0,0x5691db40,0x1732c760,0x2853cc80,0x9474ff20,0xab15f4c0,0xeab6e8e0,0xd5d7e300,
+		0x7f400c80,0x40210760,0x1821b40,0x3ee310a0,0x82c42300,0xbda528e0,0xfc0634c0,0xc3673f20,
+		0x449168e0,0x7bf06300,0x3a537f20,0x53274c0,0xb9154760,0x86744c80,0xc7d750a0,0xf8b65b40,
+		0x5221b4c0,0x6d40bf20,0x2ce3a300,0x1382a8e0,0xafa59b40,0x90c490a0,0xd1678c80,0xee068760,
+	},
+	{
+		0x0000,0xe0d20160,0x2c1c81e0,0xccce8080,0x583903c0,0xb8eb02a0,0x74258220,0x94f78340,
+		0xb0720780,0x50a006e0,0x9c6e8660,0x7cbc8700,0xe84b0440,0x8990520,0xc45785a0,0x248584c0,
+		0x8d5c8c20,0x6d8e8d40,0xa1400dc0,0x41920ca0,0xd5658fe0,0x35b78e80,0xf9790e00,0x19ab0f60,
+		0x3d2e8ba0,0xddfc8ac0,0x11320a40,0xf1e00b20,0x65178860,0x85c58900,0x490b0980,0xa9d908e0,
+		0xf7019b60,0x17d39a00,0xdb1d1a80,0x3bcf1be0,0xaf3898a0,0x4fea99c0,0x83241940,0x63f61820,
+		0x47739ce0,0xa7a19d80,0x6b6f1d00,0x8bbd1c60,0x1f4a9f20,0xff989e40,0x33561ec0,0xd3841fa0,
+		0x7a5d1740,0x9a8f1620,0x564196a0,0xb69397c0,0x22641480,0xc2b615e0,0xe789560,0xeeaa9400,
+		0xca2f10c0,0x2afd11a0,0xe6339120,0x6e19040,0x92161300,0x72c41260,0xbe0a92e0,0x5ed89380,
+		0x3bbb5e0,0xe369b480,0x2fa73400,0xcf753560,0x5b82b620,0xbb50b740,0x779e37c0,0x974c36a0,
+		0xb3c9b260,0x531bb300,0x9fd53380,0x7f0732e0,0xebf0b1a0,0xb22b0c0,0xc7ec3040,0x273e3120,
+		0x8ee739c0,0x6e3538a0,0xa2fbb820,0x4229b940,0xd6de3a00,0x360c3b60,0xfac2bbe0,0x1a10ba80,
+		0x3e953e40,0xde473f20,0x1289bfa0,0xf25bbec0,0x66ac3d80,0x867e3ce0,0x4ab0bc60,0xaa62bd00,
+		0xf4ba2e80,0x14682fe0,0xd8a6af60,0x3874ae00,0xac832d40,0x4c512c20,0x809faca0,0x604dadc0,
+		0x44c82900,0xa41a2860,0x68d4a8e0,0x8806a980,0x1cf12ac0,0xfc232ba0,0x30edab20,0xd03faa40,
+		0x79e6a2a0,0x9934a3c0,0x55fa2340,0xb5282220,0x21dfa160,0xc10da000,0xdc32080,0xed1121e0,
+		0xc994a520,0x2946a440,0xe58824c0,0x55a25a0,0x91ada6e0,0x717fa780,0xbdb12700,0x5d632660,
+		0x7776bc0,0xe7a56aa0,0x2b6bea20,0xcbb9eb40,0x5f4e6800,0xbf9c6960,0x7352e9e0,0x9380e880,
+		0xb7056c40,0x57d76d20,0x9b19eda0,0x7bcbecc0,0xef3c6f80,0xfee6ee0,0xc320ee60,0x23f2ef00,
+		0x8a2be7e0,0x6af9e680,0xa6376600,0x46e56760,0xd212e420,0x32c0e540,0xfe0e65c0,0x1edc64a0,
+		0x3a59e060,0xda8be100,0x16456180,0xf69760e0,0x6260e3a0,0x82b2e2c0,0x4e7c6240,0xaeae6320,
+		0xf076f0a0,0x10a4f1c0,0xdc6a7140,0x3cb87020,0xa84ff360,0x489df200,0x84537280,0x648173e0,
+		0x4004f720,0xa0d6f640,0x6c1876c0,0x8cca77a0,0x183df4e0,0xf8eff580,0x34217500,0xd4f37460,
+		0x7d2a7c80,0x9df87de0,0x5136fd60,0xb1e4fc00,0x25137f40,0xc5c17e20,0x90ffea0,0xe9ddffc0,
+		0xcd587b00,0x2d8a7a60,0xe144fae0,0x196fb80,0x956178c0,0x75b379a0,0xb97df920,0x59aff840,
+		0x4ccde20,0xe41edf40,0x28d05fc0,0xc8025ea0,0x5cf5dde0,0xbc27dc80,0x70e95c00,0x903b5d60,
+		0xb4bed9a0,0x546cd8c0,0x98a25840,0x78705920,0xec87da60,0xc55db00,0xc09b5b80,0x20495ae0,
+		0x89905200,0x69425360,0xa58cd3e0,0x455ed280,0xd1a951c0,0x317b50a0,0xfdb5d020,0x1d67d140,
+		0x39e25580,0xd93054e0,0x15fed460,0xf52cd500,0x61db5640,0x81095720,0x4dc7d7a0,0xad15d6c0,
+		0xf3cd4540,0x131f4420,0xdfd1c4a0,0x3f03c5c0,0xabf44680,0x4b2647e0,0x87e8c760,0x673ac600,
+		0x43bf42c0,0xa36d43a0,0x6fa3c320,0x8f71c240,0x1b864100,0xfb544060,0x379ac0e0,0xd748c180,
+		0x7e91c960,0x9e43c800,0x528d4880,0xb25f49e0,0x26a8caa0,0xc67acbc0,0xab44b40,0xea664a20,
+		0xcee3cee0,0x2e31cf80,0xe2ff4f00,0x22d4e60,0x96dacd20,0x7608cc40,0xbac64cc0,0x5a144da0,
+	},
+	{
+		0x0000,0xeeed780,0x1dddaf00,0x13337880,0x3bbb5e00,0x35558980,0x2666f100,0x28882680,
+		0x7776bc00,0x79986b80,0x6aab1300,0x6445c480,0x4ccde200,0x42233580,0x51104d00,0x5ffe9a80,
+		0xeeed7800,0xe003af80,0xf330d700,0xfdde0080,0xd5562600,0xdbb8f180,0xc88b8900,0xc6655e80,
+		0x999bc400,0x97751380,0x84466b00,0x8aa8bc80,0xa2209a00,0xacce4d80,0xbffd3500,0xb113e280,
+		0x30627320,0x3e8ca4a0,0x2dbfdc20,0x23510ba0,0xbd92d20,0x537faa0,0x16048220,0x18ea55a0,
+		0x4714cf20,0x49fa18a0,0x5ac96020,0x5427b7a0,0x7caf9120,0x724146a0,0x61723e20,0x6f9ce9a0,
+		0xde8f0b20,0xd061dca0,0xc352a420,0xcdbc73a0,0xe5345520,0xebda82a0,0xf8e9fa20,0xf6072da0,
+		0xa9f9b720,0xa71760a0,0xb4241820,0xbacacfa0,0x9242e920,0x9cac3ea0,0x8f9f4620,0x817191a0,
+		0x60c4e640,0x6e2a31c0,0x7d194940,0x73f79ec0,0x5b7fb840,0x55916fc0,0x46a21740,0x484cc0c0,
+		0x17b25a40,0x195c8dc0,0xa6ff540,0x48122c0,0x2c090440,0x22e7d3c0,0x31d4ab40,0x3f3a7cc0,
+		0x8e299e40,0x80c749c0,0x93f43140,0x9d1ae6c0,0xb592c040,0xbb7c17c0,0xa84f6f40,0xa6a1b8c0,
+		0xf95f2240,0xf7b1f5c0,0xe4828d40,0xea6c5ac0,0xc2e47c40,0xcc0aabc0,0xdf39d340,0xd1d704c0,
+		0x50a69560,0x5e4842e0,0x4d7b3a60,0x4395ede0,0x6b1dcb60,0x65f31ce0,0x76c06460,0x782eb3e0,
+		0x27d02960,0x293efee0,0x3a0d8660,0x34e351e0,0x1c6b7760,0x1285a0e0,0x1b6d860,0xf580fe0,
+		0xbe4bed60,0xb0a53ae0,0xa3964260,0xad7895e0,0x85f0b360,0x8b1e64e0,0x982d1c60,0x96c3cbe0,
+		0xc93d5160,0xc7d386e0,0xd4e0fe60,0xda0e29e0,0xf2860f60,0xfc68d8e0,0xef5ba060,0xe1b577e0,
+		0xc189cc80,0xcf671b00,0xdc546380,0xd2bab400,0xfa329280,0xf4dc4500,0xe7ef3d80,0xe901ea00,
+		0xb6ff7080,0xb811a700,0xab22df80,0xa5cc0800,0x8d442e80,0x83aaf900,0x90998180,0x9e775600,
+		0x2f64b480,0x218a6300,0x32b91b80,0x3c57cc00,0x14dfea80,0x1a313d00,0x9024580,0x7ec9200,
+		0x58120880,0x56fcdf00,0x45cfa780,0x4b217000,0x63a95680,0x6d478100,0x7e74f980,0x709a2e00,
+		0xf1ebbfa0,0xff056820,0xec3610a0,0xe2d8c720,0xca50e1a0,0xc4be3620,0xd78d4ea0,0xd9639920,
+		0x869d03a0,0x8873d420,0x9b40aca0,0x95ae7b20,0xbd265da0,0xb3c88a20,0xa0fbf2a0,0xae152520,
+		0x1f06c7a0,0x11e81020,0x2db68a0,0xc35bf20,0x24bd99a0,0x2a534e20,0x396036a0,0x378ee120,
+		0x68707ba0,0x669eac20,0x75add4a0,0x7b430320,0x53cb25a0,0x5d25f220,0x4e168aa0,0x40f85d20,
+		0xa14d2ac0,0xafa3fd40,0xbc9085c0,0xb27e5240,0x9af674c0,0x9418a340,0x872bdbc0,0x89c50c40,
+		0xd63b96c0,0xd8d54140,0xcbe639c0,0xc508ee40,0xed80c8c0,0xe36e1f40,0xf05d67c0,0xfeb3b040,
+		0x4fa052c0,0x414e8540,0x527dfdc0,0x5c932a40,0x741b0cc0,0x7af5db40,0x69c6a3c0,0x67287440,
+		0x38d6eec0,0x36383940,0x250b41c0,0x2be59640,0x36db0c0,0xd836740,0x1eb01fc0,0x105ec840,
+		0x912f59e0,0x9fc18e60,0x8cf2f6e0,0x821c2160,0xaa9407e0,0xa47ad060,0xb749a8e0,0xb9a77f60,
+		0xe659e5e0,0xe8b73260,0xfb844ae0,0xf56a9d60,0xdde2bbe0,0xd30c6c60,0xc03f14e0,0xced1c360,
+		0x7fc221e0,0x712cf660,0x621f8ee0,0x6cf15960,0x44797fe0,0x4a97a860,0x59a4d0e0,0x574a0760,
+		0x8b49de0,0x65a4a60,0x156932e0,0x1b87e560,0x330fc3e0,0x3de11460,0x2ed26ce0,0x203cbb60,
+	},
+	{
+		0x0000,0x6eab1a20,0xdd563440,0xb3fd2e60,0x5714eba0,0x39bff180,0x8a42dfe0,0xe4e9c5c0,
+		0xae29d740,0xc082cd60,0x737fe300,0x1dd4f920,0xf93d3ce0,0x979626c0,0x246b08a0,0x4ac01280,
+		0xb1eb2da0,0xdf403780,0x6cbd19e0,0x21603c0,0xe6ffc600,0x8854dc20,0x3ba9f240,0x5502e860,
+		0x1fc2fae0,0x7169e0c0,0xc294cea0,0xac3fd480,0x48d61140,0x267d0b60,0x95802500,0xfb2b3f20,
+		0x8e6ed860,0xe0c5c240,0x5338ec20,0x3d93f600,0xd97a33c0,0xb7d129e0,0x42c0780,0x6a871da0,
+		0x20470f20,0x4eec1500,0xfd113b60,0x93ba2140,0x7753e480,0x19f8fea0,0xaa05d0c0,0xc4aecae0,
+		0x3f85f5c0,0x512eefe0,0xe2d3c180,0x8c78dba0,0x68911e60,0x63a0440,0xb5c72a20,0xdb6c3000,
+		0x91ac2280,0xff0738a0,0x4cfa16c0,0x22510ce0,0xc6b8c920,0xa813d300,0x1beefd60,0x7545e740,
+		0xf16533e0,0x9fce29c0,0x2c3307a0,0x42981d80,0xa671d840,0xc8dac260,0x7b27ec00,0x158cf620,
+		0x5f4ce4a0,0x31e7fe80,0x821ad0e0,0xecb1cac0,0x8580f00,0x66f31520,0xd50e3b40,0xbba52160,
+		0x408e1e40,0x2e250460,0x9dd82a00,0xf3733020,0x179af5e0,0x7931efc0,0xcaccc1a0,0xa467db80,
+		0xeea7c900,0x800cd320,0x33f1fd40,0x5d5ae760,0xb9b322a0,0xd7183880,0x64e516e0,0xa4e0cc0,
+		0x7f0beb80,0x11a0f1a0,0xa25ddfc0,0xccf6c5e0,0x281f0020,0x46b41a00,0xf5493460,0x9be22e40,
+		0xd1223cc0,0xbf8926e0,0xc740880,0x62df12a0,0x8636d760,0xe89dcd40,0x5b60e320,0x35cbf900,
+		0xcee0c620,0xa04bdc00,0x13b6f260,0x7d1de840,0x99f42d80,0xf75f37a0,0x44a219c0,0x2a0903e0,
+		0x60c91160,0xe620b40,0xbd9f2520,0xd3343f00,0x37ddfac0,0x5976e0e0,0xea8bce80,0x8420d4a0,
+		0xf72e4e0,0x61d9fec0,0xd224d0a0,0xbc8fca80,0x58660f40,0x36cd1560,0x85303b00,0xeb9b2120,
+		0xa15b33a0,0xcff02980,0x7c0d07e0,0x12a61dc0,0xf64fd800,0x98e4c220,0x2b19ec40,0x45b2f660,
+		0xbe99c940,0xd032d360,0x63cffd00,0xd64e720,0xe98d22e0,0x872638c0,0x34db16a0,0x5a700c80,
+		0x10b01e00,0x7e1b0420,0xcde62a40,0xa34d3060,0x47a4f5a0,0x290fef80,0x9af2c1e0,0xf459dbc0,
+		0x811c3c80,0xefb726a0,0x5c4a08c0,0x32e112e0,0xd608d720,0xb8a3cd00,0xb5ee360,0x65f5f940,
+		0x2f35ebc0,0x419ef1e0,0xf263df80,0x9cc8c5a0,0x78210060,0x168a1a40,0xa5773420,0xcbdc2e00,
+		0x30f71120,0x5e5c0b00,0xeda12560,0x830a3f40,0x67e3fa80,0x948e0a0,0xbab5cec0,0xd41ed4e0,
+		0x9edec660,0xf075dc40,0x4388f220,0x2d23e800,0xc9ca2dc0,0xa76137e0,0x149c1980,0x7a3703a0,
+		0xfe17d700,0x90bccd20,0x2341e340,0x4deaf960,0xa9033ca0,0xc7a82680,0x745508e0,0x1afe12c0,
+		0x503e0040,0x3e951a60,0x8d683400,0xe3c32e20,0x72aebe0,0x6981f1c0,0xda7cdfa0,0xb4d7c580,
+		0x4ffcfaa0,0x2157e080,0x92aacee0,0xfc01d4c0,0x18e81100,0x76430b20,0xc5be2540,0xab153f60,
+		0xe1d52de0,0x8f7e37c0,0x3c8319a0,0x52280380,0xb6c1c640,0xd86adc60,0x6b97f200,0x53ce820,
+		0x70790f60,0x1ed21540,0xad2f3b20,0xc3842100,0x276de4c0,0x49c6fee0,0xfa3bd080,0x9490caa0,
+		0xde50d820,0xb0fbc200,0x306ec60,0x6dadf640,0x89443380,0xe7ef29a0,0x541207c0,0x3ab91de0,
+		0xc19222c0,0xaf3938e0,0x1cc41680,0x726f0ca0,0x9686c960,0xf82dd340,0x4bd0fd20,0x257be700,
+		0x6fbbf580,0x110efa0,0xb2edc1c0,0xdc46dbe0,0x38af1e20,0x56040400,0xe5f92a60,0x8b523040,
+	},
+	{
+		0x0000,0x1ee5c9c0,0x3dcb9380,0x232e5a40,0x7b972700,0x6572eec0,0x465cb480,0x58b97d40,
+		0xf72e4e00,0xe9cb87c0,0xcae5dd80,0xd4001440,0x8cb96900,0x925ca0c0,0xb172fa80,0xaf973340,
+		0x3e41f20,0x1d01d6e0,0x3e2f8ca0,0x20ca4560,0x78733820,0x6696f1e0,0x45b8aba0,0x5b5d6260,
+		0xf4ca5120,0xea2f98e0,0xc901c2a0,0xd7e40b60,0x8f5d7620,0x91b8bfe0,0xb296e5a0,0xac732c60,
+		0x7c83e40,0x192df780,0x3a03adc0,0x24e66400,0x7c5f1940,0x62bad080,0x41948ac0,0x5f714300,
+		0xf0e67040,0xee03b980,0xcd2de3c0,0xd3c82a00,0x8b715740,0x95949e80,0xb6bac4c0,0xa85f0d00,
+		0x42c2160,0x1ac9e8a0,0x39e7b2e0,0x27027b20,0x7fbb0660,0x615ecfa0,0x427095e0,0x5c955c20,
+		0xf3026f60,0xede7a6a0,0xcec9fce0,0xd02c3520,0x88954860,0x967081a0,0xb55edbe0,0xabbb1220,
+		0xf907c80,0x1175b540,0x325bef00,0x2cbe26c0,0x74075b80,0x6ae29240,0x49ccc800,0x572901c0,
+		0xf8be3280,0xe65bfb40,0xc575a100,0xdb9068c0,0x83291580,0x9dccdc40,0xbee28600,0xa0074fc0,
+		0xc7463a0,0x1291aa60,0x31bff020,0x2f5a39e0,0x77e344a0,0x69068d60,0x4a28d720,0x54cd1ee0,
+		0xfb5a2da0,0xe5bfe460,0xc691be20,0xd87477e0,0x80cd0aa0,0x9e28c360,0xbd069920,0xa3e350e0,
+		0x85842c0,0x16bd8b00,0x3593d140,0x2b761880,0x73cf65c0,0x6d2aac00,0x4e04f640,0x50e13f80,
+		0xff760cc0,0xe193c500,0xc2bd9f40,0xdc585680,0x84e12bc0,0x9a04e200,0xb92ab840,0xa7cf7180,
+		0xbbc5de0,0x15599420,0x3677ce60,0x289207a0,0x702b7ae0,0x6eceb320,0x4de0e960,0x530520a0,
+		0xfc9213e0,0xe277da20,0xc1598060,0xdfbc49a0,0x870534e0,0x99e0fd20,0xbacea760,0xa42b6ea0,
+		0x1f20f900,0x1c530c0,0x22eb6a80,0x3c0ea340,0x64b7de00,0x7a5217c0,0x597c4d80,0x47998440,
+		0xe80eb700,0xf6eb7ec0,0xd5c52480,0xcb20ed40,0x93999000,0x8d7c59c0,0xae520380,0xb0b7ca40,
+		0x1cc4e620,0x2212fe0,0x210f75a0,0x3feabc60,0x6753c120,0x79b608e0,0x5a9852a0,0x447d9b60,
+		0xebeaa820,0xf50f61e0,0xd6213ba0,0xc8c4f260,0x907d8f20,0x8e9846e0,0xadb61ca0,0xb353d560,
+		0x18e8c740,0x60d0e80,0x252354c0,0x3bc69d00,0x637fe040,0x7d9a2980,0x5eb473c0,0x4051ba00,
+		0xefc68940,0xf1234080,0xd20d1ac0,0xcce8d300,0x9451ae40,0x8ab46780,0xa99a3dc0,0xb77ff400,
+		0x1b0cd860,0x5e911a0,0x26c74be0,0x38228220,0x609bff60,0x7e7e36a0,0x5d506ce0,0x43b5a520,
+		0xec229660,0xf2c75fa0,0xd1e905e0,0xcf0ccc20,0x97b5b160,0x895078a0,0xaa7e22e0,0xb49beb20,
+		0x10b08580,0xe554c40,0x2d7b1600,0x339edfc0,0x6b27a280,0x75c26b40,0x56ec3100,0x4809f8c0,
+		0xe79ecb80,0xf97b0240,0xda555800,0xc4b091c0,0x9c09ec80,0x82ec2540,0xa1c27f00,0xbf27b6c0,
+		0x13549aa0,0xdb15360,0x2e9f0920,0x307ac0e0,0x68c3bda0,0x76267460,0x55082e20,0x4bede7e0,
+		0xe47ad4a0,0xfa9f1d60,0xd9b14720,0xc7548ee0,0x9fedf3a0,0x81083a60,0xa2266020,0xbcc3a9e0,
+		0x1778bbc0,0x99d7200,0x2ab32840,0x3456e180,0x6cef9cc0,0x720a5500,0x51240f40,0x4fc1c680,
+		0xe056f5c0,0xfeb33c00,0xdd9d6640,0xc378af80,0x9bc1d2c0,0x85241b00,0xa60a4140,0xb8ef8880,
+		0x149ca4e0,0xa796d20,0x29573760,0x37b2fea0,0x6f0b83e0,0x71ee4a20,0x52c01060,0x4c25d9a0,
+		0xe3b2eae0,0xfd572320,0xde797960,0xc09cb0a0,0x9825cde0,0x86c00420,0xa5ee5e60,0xbb0b97a0,
+	},
+	{
+		0x0000,0x3e41f200,0x7c83e400,0x42c21600,0xf907c800,0xc7463a00,0x85842c00,0xbbc5de00,
+		0x1fb71320,0x21f6e120,0x6334f720,0x5d750520,0xe6b0db20,0xd8f12920,0x9a333f20,0xa472cd20,
+		0x3f6e2640,0x12fd440,0x43edc240,0x7dac3040,0xc669ee40,0xf8281c40,0xbaea0a40,0x84abf840,
+		0x20d93560,0x1e98c760,0x5c5ad160,0x621b2360,0xd9defd60,0xe79f0f60,0xa55d1960,0x9b1ceb60,
+		0x7edc4c80,0x409dbe80,0x25fa880,0x3c1e5a80,0x87db8480,0xb99a7680,0xfb586080,0xc5199280,
+		0x616b5fa0,0x5f2aada0,0x1de8bba0,0x23a949a0,0x986c97a0,0xa62d65a0,0xe4ef73a0,0xdaae81a0,
+		0x41b26ac0,0x7ff398c0,0x3d318ec0,0x3707cc0,0xb8b5a2c0,0x86f450c0,0xc43646c0,0xfa77b4c0,
+		0x5e0579e0,0x60448be0,0x22869de0,0x1cc76fe0,0xa702b1e0,0x994343e0,0xdb8155e0,0xe5c0a7e0,
+		0xfdb89900,0xc3f96b00,0x813b7d00,0xbf7a8f00,0x4bf5100,0x3afea300,0x783cb500,0x467d4700,
+		0xe20f8a20,0xdc4e7820,0x9e8c6e20,0xa0cd9c20,0x1b084220,0x2549b020,0x678ba620,0x59ca5420,
+		0xc2d6bf40,0xfc974d40,0xbe555b40,0x8014a940,0x3bd17740,0x5908540,0x47529340,0x79136140,
+		0xdd61ac60,0xe3205e60,0xa1e24860,0x9fa3ba60,0x24666460,0x1a279660,0x58e58060,0x66a47260,
+		0x8364d580,0xbd252780,0xffe73180,0xc1a6c380,0x7a631d80,0x4422ef80,0x6e0f980,0x38a10b80,
+		0x9cd3c6a0,0xa29234a0,0xe05022a0,0xde11d0a0,0x65d40ea0,0x5b95fca0,0x1957eaa0,0x271618a0,
+		0xbc0af3c0,0x824b01c0,0xc08917c0,0xfec8e5c0,0x450d3bc0,0x7b4cc9c0,0x398edfc0,0x7cf2dc0,
+		0xa3bde0e0,0x9dfc12e0,0xdf3e04e0,0xe17ff6e0,0x5aba28e0,0x64fbdae0,0x2639cce0,0x18783ee0,
+		0x16c9b120,0x28884320,0x6a4a5520,0x540ba720,0xefce7920,0xd18f8b20,0x934d9d20,0xad0c6f20,
+		0x97ea200,0x373f5000,0x75fd4600,0x4bbcb400,0xf0796a00,0xce389800,0x8cfa8e00,0xb2bb7c00,
+		0x29a79760,0x17e66560,0x55247360,0x6b658160,0xd0a05f60,0xeee1ad60,0xac23bb60,0x92624960,
+		0x36108440,0x8517640,0x4a936040,0x74d29240,0xcf174c40,0xf156be40,0xb394a840,0x8dd55a40,
+		0x6815fda0,0x56540fa0,0x149619a0,0x2ad7eba0,0x911235a0,0xaf53c7a0,0xed91d1a0,0xd3d023a0,
+		0x77a2ee80,0x49e31c80,0xb210a80,0x3560f880,0x8ea52680,0xb0e4d480,0xf226c280,0xcc673080,
+		0x577bdbe0,0x693a29e0,0x2bf83fe0,0x15b9cde0,0xae7c13e0,0x903de1e0,0xd2fff7e0,0xecbe05e0,
+		0x48ccc8c0,0x768d3ac0,0x344f2cc0,0xa0edec0,0xb1cb00c0,0x8f8af2c0,0xcd48e4c0,0xf30916c0,
+		0xeb712820,0xd530da20,0x97f2cc20,0xa9b33e20,0x1276e020,0x2c371220,0x6ef50420,0x50b4f620,
+		0xf4c63b00,0xca87c900,0x8845df00,0xb6042d00,0xdc1f300,0x33800100,0x71421700,0x4f03e500,
+		0xd41f0e60,0xea5efc60,0xa89cea60,0x96dd1860,0x2d18c660,0x13593460,0x519b2260,0x6fdad060,
+		0xcba81d40,0xf5e9ef40,0xb72bf940,0x896a0b40,0x32afd540,0xcee2740,0x4e2c3140,0x706dc340,
+		0x95ad64a0,0xabec96a0,0xe92e80a0,0xd76f72a0,0x6caaaca0,0x52eb5ea0,0x102948a0,0x2e68baa0,
+		0x8a1a7780,0xb45b8580,0xf6999380,0xc8d86180,0x731dbf80,0x4d5c4d80,0xf9e5b80,0x31dfa980,
+		0xaac342e0,0x9482b0e0,0xd640a6e0,0xe80154e0,0x53c48ae0,0x6d8578e0,0x2f476ee0,0x11069ce0,
+		0xb57451c0,0x8b35a3c0,0xc9f7b5c0,0xf7b647c0,0x4c7399c0,0x72326bc0,0x30f07dc0,0xeb18fc0,
+	},
+	{
+		0x0000,0x2d936240,0x5b26c480,0x76b5a6c0,0xb64d8900,0x9bdeeb40,0xed6b4d80,0xc0f82fc0,
+		0x81239120,0xacb0f360,0xda0555a0,0xf79637e0,0x376e1820,0x1afd7a60,0x6c48dca0,0x41dbbee0,
+		0xefffa160,0xc26cc320,0xb4d965e0,0x994a07a0,0x59b22860,0x74214a20,0x294ece0,0x2f078ea0,
+		0x6edc3040,0x434f5200,0x35faf4c0,0x18699680,0xd891b940,0xf502db00,0x83b77dc0,0xae241f80,
+		0x3247c1e0,0x1fd4a3a0,0x69610560,0x44f26720,0x840a48e0,0xa9992aa0,0xdf2c8c60,0xf2bfee20,
+		0xb36450c0,0x9ef73280,0xe8429440,0xc5d1f600,0x529d9c0,0x28babb80,0x5e0f1d40,0x739c7f00,
+		0xddb86080,0xf02b02c0,0x869ea400,0xab0dc640,0x6bf5e980,0x46668bc0,0x30d32d00,0x1d404f40,
+		0x5c9bf1a0,0x710893e0,0x7bd3520,0x2a2e5760,0xead678a0,0xc7451ae0,0xb1f0bc20,0x9c63de60,
+		0x648f83c0,0x491ce180,0x3fa94740,0x123a2500,0xd2c20ac0,0xff516880,0x89e4ce40,0xa477ac00,
+		0xe5ac12e0,0xc83f70a0,0xbe8ad660,0x9319b420,0x53e19be0,0x7e72f9a0,0x8c75f60,0x25543d20,
+		0x8b7022a0,0xa6e340e0,0xd056e620,0xfdc58460,0x3d3daba0,0x10aec9e0,0x661b6f20,0x4b880d60,
+		0xa53b380,0x27c0d1c0,0x51757700,0x7ce61540,0xbc1e3a80,0x918d58c0,0xe738fe00,0xcaab9c40,
+		0x56c84220,0x7b5b2060,0xdee86a0,0x207de4e0,0xe085cb20,0xcd16a960,0xbba30fa0,0x96306de0,
+		0xd7ebd300,0xfa78b140,0x8ccd1780,0xa15e75c0,0x61a65a00,0x4c353840,0x3a809e80,0x1713fcc0,
+		0xb937e340,0x94a48100,0xe21127c0,0xcf824580,0xf7a6a40,0x22e90800,0x545caec0,0x79cfcc80,
+		0x38147260,0x15871020,0x6332b6e0,0x4ea1d4a0,0x8e59fb60,0xa3ca9920,0xd57f3fe0,0xf8ec5da0,
+		0xc91f0780,0xe48c65c0,0x9239c300,0xbfaaa140,0x7f528e80,0x52c1ecc0,0x24744a00,0x9e72840,
+		0x483c96a0,0x65aff4e0,0x131a5220,0x3e893060,0xfe711fa0,0xd3e27de0,0xa557db20,0x88c4b960,
+		0x26e0a6e0,0xb73c4a0,0x7dc66260,0x50550020,0x90ad2fe0,0xbd3e4da0,0xcb8beb60,0xe6188920,
+		0xa7c337c0,0x8a505580,0xfce5f340,0xd1769100,0x118ebec0,0x3c1ddc80,0x4aa87a40,0x673b1800,
+		0xfb58c660,0xd6cba420,0xa07e02e0,0x8ded60a0,0x4d154f60,0x60862d20,0x16338be0,0x3ba0e9a0,
+		0x7a7b5740,0x57e83500,0x215d93c0,0xccef180,0xcc36de40,0xe1a5bc00,0x97101ac0,0xba837880,
+		0x14a76700,0x39340540,0x4f81a380,0x6212c1c0,0xa2eaee00,0x8f798c40,0xf9cc2a80,0xd45f48c0,
+		0x9584f620,0xb8179460,0xcea232a0,0xe33150e0,0x23c97f20,0xe5a1d60,0x78efbba0,0x557cd9e0,
+		0xad908440,0x8003e600,0xf6b640c0,0xdb252280,0x1bdd0d40,0x364e6f00,0x40fbc9c0,0x6d68ab80,
+		0x2cb31560,0x1207720,0x7795d1e0,0x5a06b3a0,0x9afe9c60,0xb76dfe20,0xc1d858e0,0xec4b3aa0,
+		0x426f2520,0x6ffc4760,0x1949e1a0,0x34da83e0,0xf422ac20,0xd9b1ce60,0xaf0468a0,0x82970ae0,
+		0xc34cb400,0xeedfd640,0x986a7080,0xb5f912c0,0x75013d00,0x58925f40,0x2e27f980,0x3b49bc0,
+		0x9fd745a0,0xb24427e0,0xc4f18120,0xe962e360,0x299acca0,0x409aee0,0x72bc0820,0x5f2f6a60,
+		0x1ef4d480,0x3367b6c0,0x45d21000,0x68417240,0xa8b95d80,0x852a3fc0,0xf39f9900,0xde0cfb40,
+		0x7028e4c0,0x5dbb8680,0x2b0e2040,0x69d4200,0xc6656dc0,0xebf60f80,0x9d43a940,0xb0d0cb00,
+		0xf10b75e0,0xdc9817a0,0xaa2db160,0x87bed320,0x4746fce0,0x6ad59ea0,0x1c603860,0x31f35a20,
+	},
+	{
+		0x0000,0x7f868c20,0xff0d1840,0x808b9460,0x13a2b3a0,0x6c243f80,0xecafabe0,0x932927c0,
+		0x27456740,0x58c3eb60,0xd8487f00,0xa7cef320,0x34e7d4e0,0x4b6158c0,0xcbeacca0,0xb46c4080,
+		0x4e8ace80,0x310c42a0,0xb187d6c0,0xce015ae0,0x5d287d20,0x22aef100,0xa2256560,0xdda3e940,
+		0x69cfa9c0,0x164925e0,0x96c2b180,0xe9443da0,0x7a6d1a60,0x5eb9640,0x85600220,0xfae68e00,
+		0x9d159d00,0xe2931120,0x62188540,0x1d9e0960,0x8eb72ea0,0xf131a280,0x71ba36e0,0xe3cbac0,
+		0xba50fa40,0xc5d67660,0x455de200,0x3adb6e20,0xa9f249e0,0xd674c5c0,0x56ff51a0,0x2979dd80,
+		0xd39f5380,0xac19dfa0,0x2c924bc0,0x5314c7e0,0xc03de020,0xbfbb6c00,0x3f30f860,0x40b67440,
+		0xf4da34c0,0x8b5cb8e0,0xbd72c80,0x7451a0a0,0xe7788760,0x98fe0b40,0x18759f20,0x67f31300,
+		0xd793b920,0xa8153500,0x289ea160,0x57182d40,0xc4310a80,0xbbb786a0,0x3b3c12c0,0x44ba9ee0,
+		0xf0d6de60,0x8f505240,0xfdbc620,0x705d4a00,0xe3746dc0,0x9cf2e1e0,0x1c797580,0x63fff9a0,
+		0x991977a0,0xe69ffb80,0x66146fe0,0x1992e3c0,0x8abbc400,0xf53d4820,0x75b6dc40,0xa305060,
+		0xbe5c10e0,0xc1da9cc0,0x415108a0,0x3ed78480,0xadfea340,0xd2782f60,0x52f3bb00,0x2d753720,
+		0x4a862420,0x3500a800,0xb58b3c60,0xca0db040,0x59249780,0x26a21ba0,0xa6298fc0,0xd9af03e0,
+		0x6dc34360,0x1245cf40,0x92ce5b20,0xed48d700,0x7e61f0c0,0x1e77ce0,0x816ce880,0xfeea64a0,
+		0x40ceaa0,0x7b8a6680,0xfb01f2e0,0x84877ec0,0x17ae5900,0x6828d520,0xe8a34140,0x9725cd60,
+		0x23498de0,0x5ccf01c0,0xdc4495a0,0xa3c21980,0x30eb3e40,0x4f6db260,0xcfe62600,0xb060aa20,
+		0x429ff160,0x3d197d40,0xbd92e920,0xc2146500,0x513d42c0,0x2ebbcee0,0xae305a80,0xd1b6d6a0,
+		0x65da9620,0x1a5c1a00,0x9ad78e60,0xe5510240,0x76782580,0x9fea9a0,0x89753dc0,0xf6f3b1e0,
+		0xc153fe0,0x7393b3c0,0xf31827a0,0x8c9eab80,0x1fb78c40,0x60310060,0xe0ba9400,0x9f3c1820,
+		0x2b5058a0,0x54d6d480,0xd45d40e0,0xabdbccc0,0x38f2eb00,0x47746720,0xc7fff340,0xb8797f60,
+		0xdf8a6c60,0xa00ce040,0x20877420,0x5f01f800,0xcc28dfc0,0xb3ae53e0,0x3325c780,0x4ca34ba0,
+		0xf8cf0b20,0x87498700,0x7c21360,0x78449f40,0xeb6db880,0x94eb34a0,0x1460a0c0,0x6be62ce0,
+		0x9100a2e0,0xee862ec0,0x6e0dbaa0,0x118b3680,0x82a21140,0xfd249d60,0x7daf0900,0x2298520,
+		0xb645c5a0,0xc9c34980,0x4948dde0,0x36ce51c0,0xa5e77600,0xda61fa20,0x5aea6e40,0x256ce260,
+		0x950c4840,0xea8ac460,0x6a015000,0x1587dc20,0x86aefbe0,0xf92877c0,0x79a3e3a0,0x6256f80,
+		0xb2492f00,0xcdcfa320,0x4d443740,0x32c2bb60,0xa1eb9ca0,0xde6d1080,0x5ee684e0,0x216008c0,
+		0xdb8686c0,0xa4000ae0,0x248b9e80,0x5b0d12a0,0xc8243560,0xb7a2b940,0x37292d20,0x48afa100,
+		0xfcc3e180,0x83456da0,0x3cef9c0,0x7c4875e0,0xef615220,0x90e7de00,0x106c4a60,0x6feac640,
+		0x819d540,0x779f5960,0xf714cd00,0x88924120,0x1bbb66e0,0x643deac0,0xe4b67ea0,0x9b30f280,
+		0x2f5cb200,0x50da3e20,0xd051aa40,0xafd72660,0x3cfe01a0,0x43788d80,0xc3f319e0,0xbc7595c0,
+		0x46931bc0,0x391597e0,0xb99e0380,0xc6188fa0,0x5531a860,0x2ab72440,0xaa3cb020,0xd5ba3c00,
+		0x61d67c80,0x1e50f0a0,0x9edb64c0,0xe15de8e0,0x7274cf20,0xdf24300,0x8d79d760,0xf2ff5b40,
+	},
+	{
+		0x0000,0x853fe2c0,0xe7c746a0,0x62f8a460,0x22360e60,0xa709eca0,0xc5f148c0,0x40ceaa00,
+		0x446c1cc0,0xc153fe00,0xa3ab5a60,0x2694b8a0,0x665a12a0,0xe365f060,0x819d5400,0x4a2b6c0,
+		0x88d83980,0xde7db40,0x6f1f7f20,0xea209de0,0xaaee37e0,0x2fd1d520,0x4d297140,0xc8169380,
+		0xccb42540,0x498bc780,0x2b7363e0,0xae4c8120,0xee822b20,0x6bbdc9e0,0x9456d80,0x8c7a8f40,
+		0xfc08f020,0x793712e0,0x1bcfb680,0x9ef05440,0xde3efe40,0x5b011c80,0x39f9b8e0,0xbcc65a20,
+		0xb864ece0,0x3d5b0e20,0x5fa3aa40,0xda9c4880,0x9a52e280,0x1f6d0040,0x7d95a420,0xf8aa46e0,
+		0x74d0c9a0,0xf1ef2b60,0x93178f00,0x16286dc0,0x56e6c7c0,0xd3d92500,0xb1218160,0x341e63a0,
+		0x30bcd560,0xb58337a0,0xd77b93c0,0x52447100,0x128adb00,0x97b539c0,0xf54d9da0,0x70727f60,
+		0x15a96360,0x909681a0,0xf26e25c0,0x7751c700,0x379f6d00,0xb2a08fc0,0xd0582ba0,0x5567c960,
+		0x51c57fa0,0xd4fa9d60,0xb6023900,0x333ddbc0,0x73f371c0,0xf6cc9300,0x94343760,0x110bd5a0,
+		0x9d715ae0,0x184eb820,0x7ab61c40,0xff89fe80,0xbf475480,0x3a78b640,0x58801220,0xddbff0e0,
+		0xd91d4620,0x5c22a4e0,0x3eda0080,0xbbe5e240,0xfb2b4840,0x7e14aa80,0x1cec0ee0,0x99d3ec20,
+		0xe9a19340,0x6c9e7180,0xe66d5e0,0x8b593720,0xcb979d20,0x4ea87fe0,0x2c50db80,0xa96f3940,
+		0xadcd8f80,0x28f26d40,0x4a0ac920,0xcf352be0,0x8ffb81e0,0xac46320,0x683cc740,0xed032580,
+		0x6179aac0,0xe4464800,0x86beec60,0x3810ea0,0x434fa4a0,0xc6704660,0xa488e200,0x21b700c0,
+		0x2515b600,0xa02a54c0,0xc2d2f0a0,0x47ed1260,0x723b860,0x821c5aa0,0xe0e4fec0,0x65db1c00,
+		0x2b52c6c0,0xae6d2400,0xcc958060,0x49aa62a0,0x964c8a0,0x8c5b2a60,0xeea38e00,0x6b9c6cc0,
+		0x6f3eda00,0xea0138c0,0x88f99ca0,0xdc67e60,0x4d08d460,0xc83736a0,0xaacf92c0,0x2ff07000,
+		0xa38aff40,0x26b51d80,0x444db9e0,0xc1725b20,0x81bcf120,0x48313e0,0x667bb780,0xe3445540,
+		0xe7e6e380,0x62d90140,0x21a520,0x851e47e0,0xc5d0ede0,0x40ef0f20,0x2217ab40,0xa7284980,
+		0xd75a36e0,0x5265d420,0x309d7040,0xb5a29280,0xf56c3880,0x7053da40,0x12ab7e20,0x97949ce0,
+		0x93362a20,0x1609c8e0,0x74f16c80,0xf1ce8e40,0xb1002440,0x343fc680,0x56c762e0,0xd3f88020,
+		0x5f820f60,0xdabdeda0,0xb84549c0,0x3d7aab00,0x7db40100,0xf88be3c0,0x9a7347a0,0x1f4ca560,
+		0x1bee13a0,0x9ed1f160,0xfc295500,0x7916b7c0,0x39d81dc0,0xbce7ff00,0xde1f5b60,0x5b20b9a0,
+		0x3efba5a0,0xbbc44760,0xd93ce300,0x5c0301c0,0x1ccdabc0,0x99f24900,0xfb0aed60,0x7e350fa0,
+		0x7a97b960,0xffa85ba0,0x9d50ffc0,0x186f1d00,0x58a1b700,0xdd9e55c0,0xbf66f1a0,0x3a591360,
+		0xb6239c20,0x331c7ee0,0x51e4da80,0xd4db3840,0x94159240,0x112a7080,0x73d2d4e0,0xf6ed3620,
+		0xf24f80e0,0x77706220,0x1588c640,0x90b72480,0xd0798e80,0x55466c40,0x37bec820,0xb2812ae0,
+		0xc2f35580,0x47ccb740,0x25341320,0xa00bf1e0,0xe0c55be0,0x65fab920,0x7021d40,0x823dff80,
+		0x869f4940,0x3a0ab80,0x61580fe0,0xe467ed20,0xa4a94720,0x2196a5e0,0x436e0180,0xc651e340,
+		0x4a2b6c00,0xcf148ec0,0xadec2aa0,0x28d3c860,0x681d6260,0xed2280a0,0x8fda24c0,0xae5c600,
+		0xe4770c0,0x8b789200,0xe9803660,0x6cbfd4a0,0x2c717ea0,0xa94e9c60,0xcbb63800,0x4e89dac0,
+	},
+	{
+		0x0000,0x56a58d80,0xad4b1b00,0xfbee9680,0xb72eb520,0xe18b38a0,0x1a65ae20,0x4cc023a0,
+		0x83e5e960,0xd54064e0,0x2eaef260,0x780b7fe0,0x34cb5c40,0x626ed1c0,0x99804740,0xcf25cac0,
+		0xea7351e0,0xbcd6dc60,0x47384ae0,0x119dc760,0x5d5de4c0,0xbf86940,0xf016ffc0,0xa6b37240,
+		0x6996b880,0x3f333500,0xc4dda380,0x92782e00,0xdeb80da0,0x881d8020,0x73f316a0,0x25569b20,
+		0x395e20e0,0x6ffbad60,0x94153be0,0xc2b0b660,0x8e7095c0,0xd8d51840,0x233b8ec0,0x759e0340,
+		0xbabbc980,0xec1e4400,0x17f0d280,0x41555f00,0xd957ca0,0x5b30f120,0xa0de67a0,0xf67bea20,
+		0xd32d7100,0x8588fc80,0x7e666a00,0x28c3e780,0x6403c420,0x32a649a0,0xc948df20,0x9fed52a0,
+		0x50c89860,0x66d15e0,0xfd838360,0xab260ee0,0xe7e62d40,0xb143a0c0,0x4aad3640,0x1c08bbc0,
+		0x72bc41c0,0x2419cc40,0xdff75ac0,0x8952d740,0xc592f4e0,0x93377960,0x68d9efe0,0x3e7c6260,
+		0xf159a8a0,0xa7fc2520,0x5c12b3a0,0xab73e20,0x46771d80,0x10d29000,0xeb3c0680,0xbd998b00,
+		0x98cf1020,0xce6a9da0,0x35840b20,0x632186a0,0x2fe1a500,0x79442880,0x82aabe00,0xd40f3380,
+		0x1b2af940,0x4d8f74c0,0xb661e240,0xe0c46fc0,0xac044c60,0xfaa1c1e0,0x14f5760,0x57eadae0,
+		0x4be26120,0x1d47eca0,0xe6a97a20,0xb00cf7a0,0xfcccd400,0xaa695980,0x5187cf00,0x7224280,
+		0xc8078840,0x9ea205c0,0x654c9340,0x33e91ec0,0x7f293d60,0x298cb0e0,0xd2622660,0x84c7abe0,
+		0xa19130c0,0xf734bd40,0xcda2bc0,0x5a7fa640,0x16bf85e0,0x401a0860,0xbbf49ee0,0xed511360,
+		0x2274d9a0,0x74d15420,0x8f3fc2a0,0xd99a4f20,0x955a6c80,0xc3ffe100,0x38117780,0x6eb4fa00,
+		0xe5788380,0xb3dd0e00,0x48339880,0x1e961500,0x525636a0,0x4f3bb20,0xff1d2da0,0xa9b8a020,
+		0x669d6ae0,0x3038e760,0xcbd671e0,0x9d73fc60,0xd1b3dfc0,0x87165240,0x7cf8c4c0,0x2a5d4940,
+		0xf0bd260,0x59ae5fe0,0xa240c960,0xf4e544e0,0xb8256740,0xee80eac0,0x156e7c40,0x43cbf1c0,
+		0x8cee3b00,0xda4bb680,0x21a52000,0x7700ad80,0x3bc08e20,0x6d6503a0,0x968b9520,0xc02e18a0,
+		0xdc26a360,0x8a832ee0,0x716db860,0x27c835e0,0x6b081640,0x3dad9bc0,0xc6430d40,0x90e680c0,
+		0x5fc34a00,0x966c780,0xf2885100,0xa42ddc80,0xe8edff20,0xbe4872a0,0x45a6e420,0x130369a0,
+		0x3655f280,0x60f07f00,0x9b1ee980,0xcdbb6400,0x817b47a0,0xd7deca20,0x2c305ca0,0x7a95d120,
+		0xb5b01be0,0xe3159660,0x18fb00e0,0x4e5e8d60,0x29eaec0,0x543b2340,0xafd5b5c0,0xf9703840,
+		0x97c4c240,0xc1614fc0,0x3a8fd940,0x6c2a54c0,0x20ea7760,0x764ffae0,0x8da16c60,0xdb04e1e0,
+		0x14212b20,0x4284a6a0,0xb96a3020,0xefcfbda0,0xa30f9e00,0xf5aa1380,0xe448500,0x58e10880,
+		0x7db793a0,0x2b121e20,0xd0fc88a0,0x86590520,0xca992680,0x9c3cab00,0x67d23d80,0x3177b000,
+		0xfe527ac0,0xa8f7f740,0x531961c0,0x5bcec40,0x497ccfe0,0x1fd94260,0xe437d4e0,0xb2925960,
+		0xae9ae2a0,0xf83f6f20,0x3d1f9a0,0x55747420,0x19b45780,0x4f11da00,0xb4ff4c80,0xe25ac100,
+		0x2d7f0bc0,0x7bda8640,0x803410c0,0xd6919d40,0x9a51bee0,0xccf43360,0x371aa5e0,0x61bf2860,
+		0x44e9b340,0x124c3ec0,0xe9a2a840,0xbf0725c0,0xf3c70660,0xa5628be0,0x5e8c1d60,0x82990e0,
+		0xc70c5a20,0x91a9d7a0,0x6a474120,0x3ce2cca0,0x7022ef00,0x26876280,0xdd69f400,0x8bcc7980,
+	},
+	{
+		0x0000,0x27498420,0x4e930840,0x69da8c60,0x9d261080,0xba6f94a0,0xd3b518c0,0xf4fc9ce0,
+		0xd7f4a220,0xf0bd2600,0x9967aa60,0xbe2e2e40,0x4ad2b2a0,0x6d9b3680,0x441bae0,0x23083ec0,
+		0x4251c760,0x65184340,0xcc2cf20,0x2b8b4b00,0xdf77d7e0,0xf83e53c0,0x91e4dfa0,0xb6ad5b80,
+		0x95a56540,0xb2ece160,0xdb366d00,0xfc7fe920,0x88375c0,0x2fcaf1e0,0x46107d80,0x6159f9a0,
+		0x84a38ec0,0xa3ea0ae0,0xca308680,0xed7902a0,0x19859e40,0x3ecc1a60,0x57169600,0x705f1220,
+		0x53572ce0,0x741ea8c0,0x1dc424a0,0x3a8da080,0xce713c60,0xe938b840,0x80e23420,0xa7abb000,
+		0xc6f249a0,0xe1bbcd80,0x886141e0,0xaf28c5c0,0x5bd45920,0x7c9ddd00,0x15475160,0x320ed540,
+		0x1106eb80,0x364f6fa0,0x5f95e3c0,0x78dc67e0,0x8c20fb00,0xab697f20,0xc2b3f340,0xe5fa7760,
+		0xe4ff9ea0,0xc3b61a80,0xaa6c96e0,0x8d2512c0,0x79d98e20,0x5e900a00,0x374a8660,0x10030240,
+		0x330b3c80,0x1442b8a0,0x7d9834c0,0x5ad1b0e0,0xae2d2c00,0x8964a820,0xe0be2440,0xc7f7a060,
+		0xa6ae59c0,0x81e7dde0,0xe83d5180,0xcf74d5a0,0x3b884940,0x1cc1cd60,0x751b4100,0x5252c520,
+		0x715afbe0,0x56137fc0,0x3fc9f3a0,0x18807780,0xec7ceb60,0xcb356f40,0xa2efe320,0x85a66700,
+		0x605c1060,0x47159440,0x2ecf1820,0x9869c00,0xfd7a00e0,0xda3384c0,0xb3e908a0,0x94a08c80,
+		0xb7a8b240,0x90e13660,0xf93bba00,0xde723e20,0x2a8ea2c0,0xdc726e0,0x641daa80,0x43542ea0,
+		0x220dd700,0x5445320,0x6c9edf40,0x4bd75b60,0xbf2bc780,0x986243a0,0xf1b8cfc0,0xd6f14be0,
+		0xf5f97520,0xd2b0f100,0xbb6a7d60,0x9c23f940,0x68df65a0,0x4f96e180,0x264c6de0,0x105e9c0,
+		0x2447be60,0x30e3a40,0x6ad4b620,0x4d9d3200,0xb961aee0,0x9e282ac0,0xf7f2a6a0,0xd0bb2280,
+		0xf3b31c40,0xd4fa9860,0xbd201400,0x9a699020,0x6e950cc0,0x49dc88e0,0x20060480,0x74f80a0,
+		0x66167900,0x415ffd20,0x28857140,0xfccf560,0xfb306980,0xdc79eda0,0xb5a361c0,0x92eae5e0,
+		0xb1e2db20,0x96ab5f00,0xff71d360,0xd8385740,0x2cc4cba0,0xb8d4f80,0x6257c3e0,0x451e47c0,
+		0xa0e430a0,0x87adb480,0xee7738e0,0xc93ebcc0,0x3dc22020,0x1a8ba400,0x73512860,0x5418ac40,
+		0x77109280,0x505916a0,0x39839ac0,0x1eca1ee0,0xea368200,0xcd7f0620,0xa4a58a40,0x83ec0e60,
+		0xe2b5f7c0,0xc5fc73e0,0xac26ff80,0x8b6f7ba0,0x7f93e740,0x58da6360,0x3100ef00,0x16496b20,
+		0x354155e0,0x1208d1c0,0x7bd25da0,0x5c9bd980,0xa8674560,0x8f2ec140,0xe6f44d20,0xc1bdc900,
+		0xc0b820c0,0xe7f1a4e0,0x8e2b2880,0xa962aca0,0x5d9e3040,0x7ad7b460,0x130d3800,0x3444bc20,
+		0x174c82e0,0x300506c0,0x59df8aa0,0x7e960e80,0x8a6a9260,0xad231640,0xc4f99a20,0xe3b01e00,
+		0x82e9e7a0,0xa5a06380,0xcc7aefe0,0xeb336bc0,0x1fcff720,0x38867300,0x515cff60,0x76157b40,
+		0x551d4580,0x7254c1a0,0x1b8e4dc0,0x3cc7c9e0,0xc83b5500,0xef72d120,0x86a85d40,0xa1e1d960,
+		0x441bae00,0x63522a20,0xa88a640,0x2dc12260,0xd93dbe80,0xfe743aa0,0x97aeb6c0,0xb0e732e0,
+		0x93ef0c20,0xb4a68800,0xdd7c0460,0xfa358040,0xec91ca0,0x29809880,0x405a14e0,0x671390c0,
+		0x64a6960,0x2103ed40,0x48d96120,0x6f90e500,0x9b6c79e0,0xbc25fdc0,0xd5ff71a0,0xf2b6f580,
+		0xd1becb40,0xf6f74f60,0x9f2dc300,0xb8644720,0x4c98dbc0,0x6bd15fe0,0x20bd380,0x254257a0,
+	},
+	{
+		0x0000,0x488f7cc0,0x911ef980,0xd9918540,0xcf857020,0x870a0ce0,0x5e9b89a0,0x1614f560,
+		0x72b26360,0x3a3d1fa0,0xe3ac9ae0,0xab23e620,0xbd371340,0xf5b86f80,0x2c29eac0,0x64a69600,
+		0xe564c6c0,0xadebba00,0x747a3f40,0x3cf54380,0x2ae1b6e0,0x626eca20,0xbbff4f60,0xf37033a0,
+		0x97d6a5a0,0xdf59d960,0x6c85c20,0x4e4720e0,0x5853d580,0x10dca940,0xc94d2c00,0x81c250c0,
+		0x27710ea0,0x6ffe7260,0xb66ff720,0xfee08be0,0xe8f47e80,0xa07b0240,0x79ea8700,0x3165fbc0,
+		0x55c36dc0,0x1d4c1100,0xc4dd9440,0x8c52e880,0x9a461de0,0xd2c96120,0xb58e460,0x43d798a0,
+		0xc215c860,0x8a9ab4a0,0x530b31e0,0x1b844d20,0xd90b840,0x451fc480,0x9c8e41c0,0xd4013d00,
+		0xb0a7ab00,0xf828d7c0,0x21b95280,0x69362e40,0x7f22db20,0x37ada7e0,0xee3c22a0,0xa6b35e60,
+		0x4ee21d40,0x66d6180,0xdffce4c0,0x97739800,0x81676d60,0xc9e811a0,0x107994e0,0x58f6e820,
+		0x3c507e20,0x74df02e0,0xad4e87a0,0xe5c1fb60,0xf3d50e00,0xbb5a72c0,0x62cbf780,0x2a448b40,
+		0xab86db80,0xe309a740,0x3a982200,0x72175ec0,0x6403aba0,0x2c8cd760,0xf51d5220,0xbd922ee0,
+		0xd934b8e0,0x91bbc420,0x482a4160,0xa53da0,0x16b1c8c0,0x5e3eb400,0x87af3140,0xcf204d80,
+		0x699313e0,0x211c6f20,0xf88dea60,0xb00296a0,0xa61663c0,0xee991f00,0x37089a40,0x7f87e680,
+		0x1b217080,0x53ae0c40,0x8a3f8900,0xc2b0f5c0,0xd4a400a0,0x9c2b7c60,0x45baf920,0xd3585e0,
+		0x8cf7d520,0xc478a9e0,0x1de92ca0,0x55665060,0x4372a500,0xbfdd9c0,0xd26c5c80,0x9ae32040,
+		0xfe45b640,0xb6caca80,0x6f5b4fc0,0x27d43300,0x31c0c660,0x794fbaa0,0xa0de3fe0,0xe8514320,
+		0x9dc43a80,0xd54b4640,0xcdac300,0x4455bfc0,0x52414aa0,0x1ace3660,0xc35fb320,0x8bd0cfe0,
+		0xef7659e0,0xa7f92520,0x7e68a060,0x36e7dca0,0x20f329c0,0x687c5500,0xb1edd040,0xf962ac80,
+		0x78a0fc40,0x302f8080,0xe9be05c0,0xa1317900,0xb7258c60,0xffaaf0a0,0x263b75e0,0x6eb40920,
+		0xa129f20,0x429de3e0,0x9b0c66a0,0xd3831a60,0xc597ef00,0x8d1893c0,0x54891680,0x1c066a40,
+		0xbab53420,0xf23a48e0,0x2babcda0,0x6324b160,0x75304400,0x3dbf38c0,0xe42ebd80,0xaca1c140,
+		0xc8075740,0x80882b80,0x5919aec0,0x1196d200,0x7822760,0x4f0d5ba0,0x969cdee0,0xde13a220,
+		0x5fd1f2e0,0x175e8e20,0xcecf0b60,0x864077a0,0x905482c0,0xd8dbfe00,0x14a7b40,0x49c50780,
+		0x2d639180,0x65eced40,0xbc7d6800,0xf4f214c0,0xe2e6e1a0,0xaa699d60,0x73f81820,0x3b7764e0,
+		0xd32627c0,0x9ba95b00,0x4238de40,0xab7a280,0x1ca357e0,0x542c2b20,0x8dbdae60,0xc532d2a0,
+		0xa19444a0,0xe91b3860,0x308abd20,0x7805c1e0,0x6e113480,0x269e4840,0xff0fcd00,0xb780b1c0,
+		0x3642e100,0x7ecd9dc0,0xa75c1880,0xefd36440,0xf9c79120,0xb148ede0,0x68d968a0,0x20561460,
+		0x44f08260,0xc7ffea0,0xd5ee7be0,0x9d610720,0x8b75f240,0xc3fa8e80,0x1a6b0bc0,0x52e47700,
+		0xf4572960,0xbcd855a0,0x6549d0e0,0x2dc6ac20,0x3bd25940,0x735d2580,0xaacca0c0,0xe243dc00,
+		0x86e54a00,0xce6a36c0,0x17fbb380,0x5f74cf40,0x49603a20,0x1ef46e0,0xd87ec3a0,0x90f1bf60,
+		0x1133efa0,0x59bc9360,0x802d1620,0xc8a26ae0,0xdeb69f80,0x9639e340,0x4fa86600,0x7271ac0,
+		0x63818cc0,0x2b0ef000,0xf29f7540,0xba100980,0xac04fce0,0xe48b8020,0x3d1a0560,0x759579a0,
+	},
+	{
+		0x0000,0xd630f620,0x41d96f60,0x97e99940,0x83b2dec0,0x558228e0,0xc26bb1a0,0x145b4780,
+		0xeadd3ea0,0x3cedc880,0xab0451c0,0x7d34a7e0,0x696fe060,0xbf5f1640,0x28b68f00,0xfe867920,
+		0x3802fe60,0xee320840,0x79db9100,0xafeb6720,0xbbb020a0,0x6d80d680,0xfa694fc0,0x2c59b9e0,
+		0xd2dfc0c0,0x4ef36e0,0x9306afa0,0x45365980,0x516d1e00,0x875de820,0x10b47160,0xc6848740,
+		0x7005fcc0,0xa6350ae0,0x31dc93a0,0xe7ec6580,0xf3b72200,0x2587d420,0xb26e4d60,0x645ebb40,
+		0x9ad8c260,0x4ce83440,0xdb01ad00,0xd315b20,0x196a1ca0,0xcf5aea80,0x58b373c0,0x8e8385e0,
+		0x480702a0,0x9e37f480,0x9de6dc0,0xdfee9be0,0xcbb5dc60,0x1d852a40,0x8a6cb300,0x5c5c4520,
+		0xa2da3c00,0x74eaca20,0xe3035360,0x3533a540,0x2168e2c0,0xf75814e0,0x60b18da0,0xb6817b80,
+		0xe00bf980,0x363b0fa0,0xa1d296e0,0x77e260c0,0x63b92740,0xb589d160,0x22604820,0xf450be00,
+		0xad6c720,0xdce63100,0x4b0fa840,0x9d3f5e60,0x896419e0,0x5f54efc0,0xc8bd7680,0x1e8d80a0,
+		0xd80907e0,0xe39f1c0,0x99d06880,0x4fe09ea0,0x5bbbd920,0x8d8b2f00,0x1a62b640,0xcc524060,
+		0x32d43940,0xe4e4cf60,0x730d5620,0xa53da000,0xb166e780,0x675611a0,0xf0bf88e0,0x268f7ec0,
+		0x900e0540,0x463ef360,0xd1d76a20,0x7e79c00,0x13bcdb80,0xc58c2da0,0x5265b4e0,0x845542c0,
+		0x7ad33be0,0xace3cdc0,0x3b0a5480,0xed3aa2a0,0xf961e520,0x2f511300,0xb8b88a40,0x6e887c60,
+		0xa80cfb20,0x7e3c0d00,0xe9d59440,0x3fe56260,0x2bbe25e0,0xfd8ed3c0,0x6a674a80,0xbc57bca0,
+		0x42d1c580,0x94e133a0,0x308aae0,0xd5385cc0,0xc1631b40,0x1753ed60,0x80ba7420,0x568a8200,
+		0x2daf7020,0xfb9f8600,0x6c761f40,0xba46e960,0xae1daee0,0x782d58c0,0xefc4c180,0x39f437a0,
+		0xc7724e80,0x1142b8a0,0x86ab21e0,0x509bd7c0,0x44c09040,0x92f06660,0x519ff20,0xd3290900,
+		0x15ad8e40,0xc39d7860,0x5474e120,0x82441700,0x961f5080,0x402fa6a0,0xd7c63fe0,0x1f6c9c0,
+		0xff70b0e0,0x294046c0,0xbea9df80,0x689929a0,0x7cc26e20,0xaaf29800,0x3d1b0140,0xeb2bf760,
+		0x5daa8ce0,0x8b9a7ac0,0x1c73e380,0xca4315a0,0xde185220,0x828a400,0x9fc13d40,0x49f1cb60,
+		0xb777b240,0x61474460,0xf6aedd20,0x209e2b00,0x34c56c80,0xe2f59aa0,0x751c03e0,0xa32cf5c0,
+		0x65a87280,0xb39884a0,0x24711de0,0xf241ebc0,0xe61aac40,0x302a5a60,0xa7c3c320,0x71f33500,
+		0x8f754c20,0x5945ba00,0xceac2340,0x189cd560,0xcc792e0,0xdaf764c0,0x4d1efd80,0x9b2e0ba0,
+		0xcda489a0,0x1b947f80,0x8c7de6c0,0x5a4d10e0,0x4e165760,0x9826a140,0xfcf3800,0xd9ffce20,
+		0x2779b700,0xf1494120,0x66a0d860,0xb0902e40,0xa4cb69c0,0x72fb9fe0,0xe51206a0,0x3322f080,
+		0xf5a677c0,0x239681e0,0xb47f18a0,0x624fee80,0x7614a900,0xa0245f20,0x37cdc660,0xe1fd3040,
+		0x1f7b4960,0xc94bbf40,0x5ea22600,0x8892d020,0x9cc997a0,0x4af96180,0xdd10f8c0,0xb200ee0,
+		0xbda17560,0x6b918340,0xfc781a00,0x2a48ec20,0x3e13aba0,0xe8235d80,0x7fcac4c0,0xa9fa32e0,
+		0x577c4bc0,0x814cbde0,0x16a524a0,0xc095d280,0xd4ce9500,0x2fe6320,0x9517fa60,0x43270c40,
+		0x85a38b00,0x53937d20,0xc47ae460,0x124a1240,0x61155c0,0xd021a3e0,0x47c83aa0,0x91f8cc80,
+		0x6f7eb5a0,0xb94e4380,0x2ea7dac0,0xf8972ce0,0xeccc6b60,0x3afc9d40,0xad150400,0x7b25f220,
+	},
+	{
+		0x0000,0x5b5ee040,0xb6bdc080,0xede320c0,0x80c30220,0xdb9de260,0x367ec2a0,0x6d2022e0,
+		0xec3e8760,0xb7606720,0x5a8347e0,0x1dda7a0,0x6cfd8540,0x37a36500,0xda4045c0,0x811ea580,
+		0x35c58de0,0x6e9b6da0,0x83784d60,0xd826ad20,0xb5068fc0,0xee586f80,0x3bb4f40,0x58e5af00,
+		0xd9fb0a80,0x82a5eac0,0x6f46ca00,0x34182a40,0x593808a0,0x266e8e0,0xef85c820,0xb4db2860,
+		0x6b8b1bc0,0x30d5fb80,0xdd36db40,0x86683b00,0xeb4819e0,0xb016f9a0,0x5df5d960,0x6ab3920,
+		0x87b59ca0,0xdceb7ce0,0x31085c20,0x6a56bc60,0x7769e80,0x5c287ec0,0xb1cb5e00,0xea95be40,
+		0x5e4e9620,0x5107660,0xe8f356a0,0xb3adb6e0,0xde8d9400,0x85d37440,0x68305480,0x336eb4c0,
+		0xb2701140,0xe92ef100,0x4cdd1c0,0x5f933180,0x32b31360,0x69edf320,0x840ed3e0,0xdf5033a0,
+		0xd7163780,0x8c48d7c0,0x61abf700,0x3af51740,0x57d535a0,0xc8bd5e0,0xe168f520,0xba361560,
+		0x3b28b0e0,0x607650a0,0x8d957060,0xd6cb9020,0xbbebb2c0,0xe0b55280,0xd567240,0x56089200,
+		0xe2d3ba60,0xb98d5a20,0x546e7ae0,0xf309aa0,0x6210b840,0x394e5800,0xd4ad78c0,0x8ff39880,
+		0xeed3d00,0x55b3dd40,0xb850fd80,0xe30e1dc0,0x8e2e3f20,0xd570df60,0x3893ffa0,0x63cd1fe0,
+		0xbc9d2c40,0xe7c3cc00,0xa20ecc0,0x517e0c80,0x3c5e2e60,0x6700ce20,0x8ae3eee0,0xd1bd0ea0,
+		0x50a3ab20,0xbfd4b60,0xe61e6ba0,0xbd408be0,0xd060a900,0x8b3e4940,0x66dd6980,0x3d8389c0,
+		0x8958a1a0,0xd20641e0,0x3fe56120,0x64bb8160,0x99ba380,0x52c543c0,0xbf266300,0xe4788340,
+		0x656626c0,0x3e38c680,0xd3dbe640,0x88850600,0xe5a524e0,0xbefbc4a0,0x5318e460,0x8460420,
+		0x4394ec20,0x18ca0c60,0xf5292ca0,0xae77cce0,0xc357ee00,0x98090e40,0x75ea2e80,0x2eb4cec0,
+		0xafaa6b40,0xf4f48b00,0x1917abc0,0x42494b80,0x2f696960,0x74378920,0x99d4a9e0,0xc28a49a0,
+		0x765161c0,0x2d0f8180,0xc0eca140,0x9bb24100,0xf69263e0,0xadcc83a0,0x402fa360,0x1b714320,
+		0x9a6fe6a0,0xc13106e0,0x2cd22620,0x778cc660,0x1aace480,0x41f204c0,0xac112400,0xf74fc440,
+		0x281ff7e0,0x734117a0,0x9ea23760,0xc5fcd720,0xa8dcf5c0,0xf3821580,0x1e613540,0x453fd500,
+		0xc4217080,0x9f7f90c0,0x729cb000,0x29c25040,0x44e272a0,0x1fbc92e0,0xf25fb220,0xa9015260,
+		0x1dda7a00,0x46849a40,0xab67ba80,0xf0395ac0,0x9d197820,0xc6479860,0x2ba4b8a0,0x70fa58e0,
+		0xf1e4fd60,0xaaba1d20,0x47593de0,0x1c07dda0,0x7127ff40,0x2a791f00,0xc79a3fc0,0x9cc4df80,
+		0x9482dba0,0xcfdc3be0,0x223f1b20,0x7961fb60,0x1441d980,0x4f1f39c0,0xa2fc1900,0xf9a2f940,
+		0x78bc5cc0,0x23e2bc80,0xce019c40,0x955f7c00,0xf87f5ee0,0xa321bea0,0x4ec29e60,0x159c7e20,
+		0xa1475640,0xfa19b600,0x17fa96c0,0x4ca47680,0x21845460,0x7adab420,0x973994e0,0xcc6774a0,
+		0x4d79d120,0x16273160,0xfbc411a0,0xa09af1e0,0xcdbad300,0x96e43340,0x7b071380,0x2059f3c0,
+		0xff09c060,0xa4572020,0x49b400e0,0x12eae0a0,0x7fcac240,0x24942200,0xc97702c0,0x9229e280,
+		0x13374700,0x4869a740,0xa58a8780,0xfed467c0,0x93f44520,0xc8aaa560,0x254985a0,0x7e1765e0,
+		0xcacc4d80,0x9192adc0,0x7c718d00,0x272f6d40,0x4a0f4fa0,0x1151afe0,0xfcb28f20,0xa7ec6f60,
+		0x26f2cae0,0x7dac2aa0,0x904f0a60,0xcb11ea20,0xa631c8c0,0xfd6f2880,0x108c0840,0x4bd2e800,
+	},
+	{
+		0x0000,0x8729d840,0xe3eb33a0,0x64c2ebe0,0x2a6ee460,0xad473c20,0xc985d7c0,0x4eac0f80,
+		0x54ddc8c0,0xd3f41080,0xb736fb60,0x301f2320,0x7eb32ca0,0xf99af4e0,0x9d581f00,0x1a71c740,
+		0xa9bb9180,0x2e9249c0,0x4a50a220,0xcd797a60,0x83d575e0,0x4fcada0,0x603e4640,0xe7179e00,
+		0xfd665940,0x7a4f8100,0x1e8d6ae0,0x99a4b2a0,0xd708bd20,0x50216560,0x34e38e80,0xb3ca56c0,
+		0xbecfa020,0x39e67860,0x5d249380,0xda0d4bc0,0x94a14440,0x13889c00,0x774a77e0,0xf063afa0,
+		0xea1268e0,0x6d3bb0a0,0x9f95b40,0x8ed08300,0xc07c8c80,0x475554c0,0x2397bf20,0xa4be6760,
+		0x177431a0,0x905de9e0,0xf49f0200,0x73b6da40,0x3d1ad5c0,0xba330d80,0xdef1e660,0x59d83e20,
+		0x43a9f960,0xc4802120,0xa042cac0,0x276b1280,0x69c71d00,0xeeeec540,0x8a2c2ea0,0xd05f6e0,
+		0x9027c360,0x170e1b20,0x73ccf0c0,0xf4e52880,0xba492700,0x3d60ff40,0x59a214a0,0xde8bcce0,
+		0xc4fa0ba0,0x43d3d3e0,0x27113800,0xa038e040,0xee94efc0,0x69bd3780,0xd7fdc60,0x8a560420,
+		0x399c52e0,0xbeb58aa0,0xda776140,0x5d5eb900,0x13f2b680,0x94db6ec0,0xf0198520,0x77305d60,
+		0x6d419a20,0xea684260,0x8eaaa980,0x98371c0,0x472f7e40,0xc006a600,0xa4c44de0,0x23ed95a0,
+		0x2ee86340,0xa9c1bb00,0xcd0350e0,0x4a2a88a0,0x4868720,0x83af5f60,0xe76db480,0x60446cc0,
+		0x7a35ab80,0xfd1c73c0,0x99de9820,0x1ef74060,0x505b4fe0,0xd77297a0,0xb3b07c40,0x3499a400,
+		0x8753f2c0,0x7a2a80,0x64b8c160,0xe3911920,0xad3d16a0,0x2a14cee0,0x4ed62500,0xc9fffd40,
+		0xd38e3a00,0x54a7e240,0x306509a0,0xb74cd1e0,0xf9e0de60,0x7ec90620,0x1a0bedc0,0x9d223580,
+		0xcdf705e0,0x4adedda0,0x2e1c3640,0xa935ee00,0xe799e180,0x60b039c0,0x472d220,0x835b0a60,
+		0x992acd20,0x1e031560,0x7ac1fe80,0xfde826c0,0xb3442940,0x346df100,0x50af1ae0,0xd786c2a0,
+		0x644c9460,0xe3654c20,0x87a7a7c0,0x8e7f80,0x4e227000,0xc90ba840,0xadc943a0,0x2ae09be0,
+		0x30915ca0,0xb7b884e0,0xd37a6f00,0x5453b740,0x1affb8c0,0x9dd66080,0xf9148b60,0x7e3d5320,
+		0x7338a5c0,0xf4117d80,0x90d39660,0x17fa4e20,0x595641a0,0xde7f99e0,0xbabd7200,0x3d94aa40,
+		0x27e56d00,0xa0ccb540,0xc40e5ea0,0x432786e0,0xd8b8960,0x8aa25120,0xee60bac0,0x69496280,
+		0xda833440,0x5daaec00,0x396807e0,0xbe41dfa0,0xf0edd020,0x77c40860,0x1306e380,0x942f3bc0,
+		0x8e5efc80,0x97724c0,0x6db5cf20,0xea9c1760,0xa43018e0,0x2319c0a0,0x47db2b40,0xc0f2f300,
+		0x5dd0c680,0xdaf91ec0,0xbe3bf520,0x39122d60,0x77be22e0,0xf097faa0,0x94551140,0x137cc900,
+		0x90d0e40,0x8e24d600,0xeae63de0,0x6dcfe5a0,0x2363ea20,0xa44a3260,0xc088d980,0x47a101c0,
+		0xf46b5700,0x73428f40,0x178064a0,0x90a9bce0,0xde05b360,0x592c6b20,0x3dee80c0,0xbac75880,
+		0xa0b69fc0,0x279f4780,0x435dac60,0xc4747420,0x8ad87ba0,0xdf1a3e0,0x69334800,0xee1a9040,
+		0xe31f66a0,0x6436bee0,0xf45500,0x87dd8d40,0xc97182c0,0x4e585a80,0x2a9ab160,0xadb36920,
+		0xb7c2ae60,0x30eb7620,0x54299dc0,0xd3004580,0x9dac4a00,0x1a859240,0x7e4779a0,0xf96ea1e0,
+		0x4aa4f720,0xcd8d2f60,0xa94fc480,0x2e661cc0,0x60ca1340,0xe7e3cb00,0x832120e0,0x408f8a0,
+		0x1e793fe0,0x9950e7a0,0xfd920c40,0x7abbd400,0x3417db80,0xb33e03c0,0xd7fce820,0x50d53060,
+	},
+};
 constexpr u32 CRC32_POLYNOMIAL = 0xedb88320;
-u32 crc32(Slice<u8> buf){
+constexpr u64 crc32_fold_k[17][2] = {
+	{0x00000001, 0x6eab1a20},
+	{0x488f7cc0, 0x2e058d00},
+	{0x14357e80, 0x6afa3b20},
+	{0x1b784f00, 0x1bd339a0},
+	{0xe24f14c0, 0x1b5f3a20},
+	{0x3e6ac060, 0x3e1bf080},
+	{0xc805df40, 0xa653b560},
+	{0x9752ff80, 0xec34a120},
+	{0x986f29a0, 0xefcaaa60},
+	{0xfb4fd500, 0xa852f360},
+	{0x8c971920, 0x08521640},
+	{0x8bab5220, 0xb438e0a0},
+	{0x6a8b10a0, 0x45898020},
+	{0x592019e0, 0xc34a0ac0},
+	{0x715b4620, 0xcca52b00},
+	{0xe66571c0, 0xddd0a480},
+	{0xe0805580, 0xef6a9d00},
+};
+constexpr u32 crc32_xpow8n[64] = {
+	0x0100,0x10000,0xedb88320,0x6eab1a20,0x488f7cc0,0x14357e80,0xe24f14c0,0x986f29a0,
+	0xe0805580,0x11056140,0x4c71ede0,0x36670ac0,0xeb4ee060,0xc3ae5a00,0xdb89d320,0xb0c6bb00,
+	0xbe549460,0x8bab5a40,0x809325c0,0x6e19d540,0x22aa760,0xe511120,0x28670e80,0x336e1de0,
+	0xe807c9a0,0x3db71060,0xf6dc4180,0x0100,0x10000,0xedb88320,0x6eab1a20,0x488f7cc0,
+	0x14357e80,0xe24f14c0,0x986f29a0,0xe0805580,0x11056140,0x4c71ede0,0x36670ac0,0xeb4ee060,
+	0xc3ae5a00,0xdb89d320,0xb0c6bb00,0xbe549460,0x8bab5a40,0x809325c0,0x6e19d540,0x22aa760,
+	0xe511120,0x28670e80,0x336e1de0,0xe807c9a0,0x3db71060,0xf6dc4180,0x0100,0x10000,
+	0xedb88320,0x6eab1a20,0x488f7cc0,0x14357e80,0xe24f14c0,0x986f29a0,0xe0805580,0x11056140,
+};
+static inline
+u32 crc32_load_be32(u8 const* p){
+	return (u32(p[0]) << 24) | (u32(p[1]) << 16) | (u32(p[2]) << 8) | u32(p[3]);
+}
+
+static inline
+u32 crc32_bytewise_ex(u32 remainder, u8 const* data, usize len){
 	constexpr u32 bit_width = sizeof(u32) * 8;
-    u8 data = 0;
-    u32 remainder = 0;
 
-    for (usize i = 0; i < buf.len; ++i) {
-        data = buf[i] ^ (remainder >> (bit_width - 8));
-        remainder = crc32_lut[data] ^ (remainder << 8);
-    }
+	for (usize i = 0; i < len; ++i) {
+		u8 index = data[i] ^ (remainder >> (bit_width - 8));
+		remainder = crc32_lut[index] ^ (remainder << 8);
+	}
+
+	return remainder;
+}
+
+u32 crc32_bytewise(Slice<u8> buf){
+	return crc32_bytewise_ex(0, buf.data, buf.len);
+}
+
+u32 crc32_slice8(Slice<u8> buf){
+	auto const& lut = crc32_lut_sliced;
+	u8 const* p = buf.data;
+	usize n = buf.len;
+	u32 remainder = 0;
+
+	for(; n >= 8; n -= 8, p += 8){
+		u32 hi = remainder ^ crc32_load_be32(p);
+		u32 lo = crc32_load_be32(p + 4);
+		remainder =
+			lut[7][hi >> 24] ^ lut[6][(hi >> 16) & 0xff] ^ lut[5][(hi >> 8) & 0xff] ^ lut[4][hi & 0xff] ^
+			lut[3][lo >> 24] ^ lut[2][(lo >> 16) & 0xff] ^ lut[1][(lo >> 8) & 0xff] ^ lut[0][lo & 0xff];
+	}
+
+	return crc32_bytewise_ex(remainder, p, n);
+}
+
+static
+u32 crc32_slice16_ex(u32 remainder, u8 const* p, usize n){
+	auto const& lut = crc32_lut_sliced;
+
+	for(; n >= 16; n -= 16, p += 16){
+		u32 w0 = remainder ^ crc32_load_be32(p);
+		u32 w1 = crc32_load_be32(p + 4);
+		u32 w2 = crc32_load_be32(p + 8);
+		u32 w3 = crc32_load_be32(p + 12);
+		remainder =
+			lut[15][w0 >> 24] ^ lut[14][(w0 >> 16) & 0xff] ^ lut[13][(w0 >> 8) & 0xff] ^ lut[12][w0 & 0xff] ^
+			lut[11][w1 >> 24] ^ lut[10][(w1 >> 16) & 0xff] ^ lut[9][(w1 >> 8) & 0xff]  ^ lut[8][w1 & 0xff]  ^
+			lut[7][w2 >> 24]  ^ lut[6][(w2 >> 16) & 0xff]  ^ lut[5][(w2 >> 8) & 0xff]  ^ lut[4][w2 & 0xff]  ^
+			lut[3][w3 >> 24]  ^ lut[2][(w3 >> 16) & 0xff]  ^ lut[1][(w3 >> 8) & 0xff]  ^ lut[0][w3 & 0xff];
+	}
+
+	return crc32_bytewise_ex(remainder, p, n);
+}
+
+u32 crc32_slice16(Slice<u8> buf){
+	return crc32_slice16_ex(0, buf.data, buf.len);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+/* Carry-less multiply folding. Blocks are byte swapped so that a 128 bit lane holds the message
+ * polynomial with its highest degree term in the top bit, then each block B is moved forward by D
+ * bits as B.hi * (x^(D+64) mod P) ^ B.lo * (x^D mod P), which keeps it congruent modulo P. Once the
+ * input is folded into a single block its remainder is taken with the table, since the CRC of a
+ * message only depends on the message modulo P. */
+
+#define CRC32_PCLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+#define CRC32_VPCLMUL_TARGET __attribute__((target("pclmul,ssse3,avx512f,avx512bw,vpclmulqdq")))
+
+CRC32_PCLMUL_TARGET static inline
+__m128i crc32_fold_128(__m128i x, __m128i k){
+	return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+CRC32_PCLMUL_TARGET static inline
+__m128i crc32_fold_k128(usize d){
+	return _mm_set_epi64x((long long)crc32_fold_k[d][1], (long long)crc32_fold_k[d][0]);
+}
+
+CRC32_PCLMUL_TARGET static inline
+__m128i crc32_load_128(u8 const* p){
+	const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	return _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)p), bswap);
+}
+
+/* Reduce the last folded block and any trailing bytes */
+CRC32_PCLMUL_TARGET static inline
+u32 crc32_fold_finish(__m128i x, u8 const* p, usize n){
+	const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	u8 block[16];
+	_mm_storeu_si128((__m128i*)block, _mm_shuffle_epi8(x, bswap));
+	u32 remainder = crc32_slice16_ex(0, block, 16);
+	return crc32_slice16_ex(remainder, p, n);
+}
+
+CRC32_PCLMUL_TARGET static
+u32 crc32_pclmul_ex(u32 remainder, u8 const* p, usize n){
+	if(n < 128){
+		return crc32_slice16_ex(remainder, p, n);
+	}
+
+	__m128i x0 = _mm_xor_si128(crc32_load_128(p), _mm_set_epi32(int(remainder), 0, 0, 0));
+	__m128i x1 = crc32_load_128(p + 16);
+	__m128i x2 = crc32_load_128(p + 32);
+	__m128i x3 = crc32_load_128(p + 48);
+	p += 64; n -= 64;
+
+	__m128i k4 = crc32_fold_k128(4);
+	for(; n >= 64; n -= 64, p += 64){
+		x0 = _mm_xor_si128(crc32_fold_128(x0, k4), crc32_load_128(p));
+		x1 = _mm_xor_si128(crc32_fold_128(x1, k4), crc32_load_128(p + 16));
+		x2 = _mm_xor_si128(crc32_fold_128(x2, k4), crc32_load_128(p + 32));
+		x3 = _mm_xor_si128(crc32_fold_128(x3, k4), crc32_load_128(p + 48));
+	}
+
+	__m128i x = _mm_xor_si128(
+		_mm_xor_si128(crc32_fold_128(x0, crc32_fold_k128(3)), crc32_fold_128(x1, crc32_fold_k128(2))),
+		_mm_xor_si128(crc32_fold_128(x2, crc32_fold_k128(1)), x3));
+
+	__m128i k1 = crc32_fold_k128(1);
+	for(; n >= 16; n -= 16, p += 16){
+		x = _mm_xor_si128(crc32_fold_128(x, k1), crc32_load_128(p));
+	}
+
+	return crc32_fold_finish(x, p, n);
+}
+
+CRC32_VPCLMUL_TARGET static inline
+__m512i crc32_fold_512(__m512i x, __m512i k, __m512i data){
+	/* 0x96 is a three way xor */
+	return _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(x, k, 0x00), _mm512_clmulepi64_epi128(x, k, 0x11), data, 0x96);
+}
+
+CRC32_VPCLMUL_TARGET static inline
+__m512i crc32_fold_k512(usize d){
+	return _mm512_set4_epi64((long long)crc32_fold_k[d][1], (long long)crc32_fold_k[d][0], (long long)crc32_fold_k[d][1], (long long)crc32_fold_k[d][0]);
+}
+
+CRC32_VPCLMUL_TARGET static inline
+__m512i crc32_load_512(u8 const* p){
+	const __m512i bswap = _mm512_set4_epi32(0x00010203, 0x04050607, 0x08090a0b, 0x0c0d0e0f);
+	return _mm512_shuffle_epi8(_mm512_loadu_si512((void const*)p), bswap);
+}
+
+CRC32_VPCLMUL_TARGET static
+u32 crc32_vpclmul_ex(u32 remainder, u8 const* p, usize n){
+	if(n < 512){
+		return crc32_pclmul_ex(remainder, p, n);
+	}
+
+	__m512i seed = _mm512_inserti32x4(_mm512_setzero_si512(), _mm_set_epi32(int(remainder), 0, 0, 0), 0);
+	__m512i z0 = _mm512_xor_si512(crc32_load_512(p), seed);
+	__m512i z1 = crc32_load_512(p + 64);
+	__m512i z2 = crc32_load_512(p + 128);
+	__m512i z3 = crc32_load_512(p + 192);
+	p += 256; n -= 256;
+
+	__m512i k16 = crc32_fold_k512(16);
+	for(; n >= 256; n -= 256, p += 256){
+		z0 = crc32_fold_512(z0, k16, crc32_load_512(p));
+		z1 = crc32_fold_512(z1, k16, crc32_load_512(p + 64));
+		z2 = crc32_fold_512(z2, k16, crc32_load_512(p + 128));
+		z3 = crc32_fold_512(z3, k16, crc32_load_512(p + 192));
+	}
+
+	__m512i z = crc32_fold_512(z0, crc32_fold_k512(12), z3);
+	z = crc32_fold_512(z1, crc32_fold_k512(8), z);
+	z = crc32_fold_512(z2, crc32_fold_k512(4), z);
+
+	__m512i k4 = crc32_fold_k512(4);
+	for(; n >= 64; n -= 64, p += 64){
+		z = crc32_fold_512(z, k4, crc32_load_512(p));
+	}
+
+	__m128i lanes[4];
+	_mm512_storeu_si512((void*)lanes, z);
+	__m128i x = _mm_xor_si128(
+		_mm_xor_si128(crc32_fold_128(lanes[0], crc32_fold_k128(3)), crc32_fold_128(lanes[1], crc32_fold_k128(2))),
+		_mm_xor_si128(crc32_fold_128(lanes[2], crc32_fold_k128(1)), lanes[3]));
+
+	__m128i k1 = crc32_fold_k128(1);
+	for(; n >= 16; n -= 16, p += 16){
+		x = _mm_xor_si128(crc32_fold_128(x, k1), crc32_load_128(p));
+	}
+
+	return crc32_fold_finish(x, p, n);
+}
+
+u32 crc32_pclmul(Slice<u8> buf){
+	ensure(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3), "CPU does not support PCLMULQDQ");
+	return crc32_pclmul_ex(0, buf.data, buf.len);
+}
+
+u32 crc32_vpclmul(Slice<u8> buf){
+	ensure(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3 | CPUFeature_AVX512F | CPUFeature_AVX512BW | CPUFeature_VPCLMULQDQ), "CPU does not support VPCLMULQDQ");
+	return crc32_vpclmul_ex(0, buf.data, buf.len);
+}
+#endif
+
+using CRC32Proc = u32 (*)(u32 remainder, u8 const* p, usize n);
+
+struct CRC32Impl {
+	CRC32Proc proc;
+	cstring   name;
+};
+
+static
+CRC32Impl crc32_select(){
+#if defined(__x86_64__) || defined(__i386__)
+	if(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3 | CPUFeature_AVX512F | CPUFeature_AVX512BW | CPUFeature_VPCLMULQDQ)){
+		return { crc32_vpclmul_ex, "vpclmulqdq" };
+	}
+	if(cpu_has(CPUFeature_PCLMUL | CPUFeature_SSSE3)){
+		return { crc32_pclmul_ex, "pclmulqdq" };
+	}
+#endif
+	return { crc32_slice16_ex, "slice16" };
+}
+
+/* Selected once during static initialization */
+static const CRC32Impl crc32_impl = crc32_select();
+
+cstring crc32_implementation(){
+	return crc32_impl.name;
+}
+
+u32 crc32(Slice<u8> buf){
+	return crc32_impl.proc(0, buf.data, buf.len);
+}
+
+CRC32_State crc32_begin(){
+	return CRC32_State{ 0 };
+}
+
+void crc32_update(CRC32_State* state, Slice<u8> buf){
+	state->remainder = crc32_impl.proc(state->remainder, buf.data, buf.len);
+}
+
+u32 crc32_finish(CRC32_State* state){
+	return state->remainder;
+}
+
+static
+u32 crc32_multmodp(u32 a, u32 b){
+	u32 product = 0;
+	for(i32 bit = 31; bit >= 0; bit -= 1){
+		product = (product & 0x80000000) ? ((product << 1) ^ CRC32_POLYNOMIAL) : (product << 1);
+		if((b >> bit) & 1){
+			product ^= a;
+		}
+	}
+	return product;
+}
+
+/* x^(8n) mod P */
+static
+u32 crc32_xpow8(u64 n){
+	u32 result = 1;
+	for(usize k = 0; n != 0; n >>= 1, k += 1){
+		if(n & 1){
+			result = crc32_multmodp(result, crc32_xpow8n[k]);
+		}
+	}
+	return result;
+}
+
+u32 crc32_combine(u32 crc_a, u32 crc_b, usize len_b){
+	/* With a zero initial value and no final xor CRC is linear: CRC(A || B) = CRC(A) * x^(8 len(B)) + CRC(B) */
+	return crc32_multmodp(crc_a, crc32_xpow8(len_b)) ^ crc_b;
+}
+
+constexpr usize CRC32_PARALLEL_MIN_CHUNK = 256 * 1024;
+constexpr usize CRC32_PARALLEL_MAX_CHUNKS = 256;
+
+struct CRC32_Chunk {
+	Slice<u8> data;
+	u32 crc;
+};
+
+static
+void crc32_chunk_task(void* arg){
+	auto chunk = (CRC32_Chunk*)arg;
+	chunk->crc = crc32(chunk->data);
+}
+
+u32 crc32_parallel(Scheduler* sched, Slice<u8> buf){
+	usize chunk_count = min(CRC32_PARALLEL_MAX_CHUNKS, min(sched->workers.len * 4, buf.len / CRC32_PARALLEL_MIN_CHUNK));
+	if(chunk_count <= 1){
+		return crc32(buf);
+	}
+
+	CRC32_Chunk chunks[CRC32_PARALLEL_MAX_CHUNKS];
+	usize chunk_size = (buf.len + chunk_count - 1) / chunk_count;
+
+	TaskGroup group = {};
+	for(usize i = 0; i < chunk_count; i += 1){
+		usize start = i * chunk_size;
+		usize end = min(buf.len, start + chunk_size);
+		chunks[i] = CRC32_Chunk{ slice(buf, start, end), 0 };
+		if(!sched_submit(sched, &group, crc32_chunk_task, &chunks[i])){
+			crc32_chunk_task(&chunks[i]);
+		}
+	}
+	sched_wait(sched, &group);
+
+	u32 result = chunks[0].crc;
+	for(usize i = 1; i < chunk_count; i += 1){
+		result = crc32_combine(result, chunks[i].crc, chunks[i].data.len);
+	}
+	return result;
+}
+
+bool crc32_file(String path, u32* crc){
+	/* Mapped files are hashed in place, anything else is streamed through a fixed buffer */
+	Slice<u8> data = file_map(path, FileMapHint_Sequential);
+	if(data.data){
+		*crc = crc32(data);
+		file_unmap(data);
+		return true;
+	}
+
+	ChunkReader r;
+	if(!chunk_reader_open(&r, path)){ return false; }
+	auto buf = make_slice_uninit<u8>(heap_allocator(), CHUNK_READER_SIZE);
+	if(!buf.data){
+		chunk_reader_close(&r);
+		return false;
+	}
+
+	CRC32_State state = crc32_begin();
+	for(usize n = chunk_read(&r, buf); n > 0; n = chunk_read(&r, buf)){
+		crc32_update(&state, take(buf, n));
+	}
+	bool ok = !r.failed;
+	chunk_reader_close(&r);
+	mem_free(heap_allocator(), buf.data, buf.len, 1);
 
-    return remainder;
+	*crc = crc32_finish(&state);
+	return ok;
 }
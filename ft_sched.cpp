@@ -0,0 +1,357 @@
+#include "ft_sched.hpp"
+
+constexpr i64 TASK_QUEUE_INITIAL_CAP = 256;
+constexpr i32 WORKER_SPIN_COUNT = 64;
+constexpr i32 WORKER_YIELD_COUNT = 16;
+constexpr usize TASK_POOL_CHUNK_BLOCKS = 1024;
+
+static thread_local Worker* sched_current_worker = nullptr;
+
+//// Task queue
+static
+TaskBuffer* task_buffer_create(Allocator a, i64 cap){
+	ensure(mem_valid_alignment(usize(cap)), "Task buffer capacity must be a power of 2");
+	auto buf = make<TaskBuffer>(a);
+	if(!buf){ return nullptr; }
+
+	/* Slots are always written before they are read */
+	auto data = make_slice_uninit<Task*>(a, usize(cap));
+	if(!data.data){
+		mem_free(a, buf, sizeof(TaskBuffer), alignof(TaskBuffer));
+		return nullptr;
+	}
+
+	buf->data = data.data;
+	buf->cap = cap;
+	buf->prev = nullptr;
+	return buf;
+}
+
+static
+void task_buffer_destroy(Allocator a, TaskBuffer* buf){
+	while(buf){
+		TaskBuffer* prev = buf->prev;
+		mem_free(a, buf->data, sizeof(Task*) * usize(buf->cap), alignof(Task*));
+		mem_free(a, buf, sizeof(TaskBuffer), alignof(TaskBuffer));
+		buf = prev;
+	}
+}
+
+static
+bool task_queue_init(TaskQueue* q, Allocator a){
+	mem_zero(q, sizeof(*q));
+	q->buffer = task_buffer_create(a, TASK_QUEUE_INITIAL_CAP);
+	return q->buffer != nullptr;
+}
+
+/* Owner only. The old buffer is retired, not freed, as a thief may have loaded it already */
+static
+TaskBuffer* task_queue_grow(TaskQueue* q, Allocator a, TaskBuffer* old, i64 top, i64 bottom){
+	TaskBuffer* buf = task_buffer_create(a, old->cap * 2);
+	if(!buf){ return nullptr; }
+
+	for(i64 i = top; i < bottom; i += 1){
+		buf->data[i & (buf->cap - 1)] = atomic_load(&old->data[i & (old->cap - 1)], MemoryOrder_Relaxed);
+	}
+	buf->prev = old;
+	atomic_store(&q->buffer, buf, MemoryOrder_Release);
+	return buf;
+}
+
+/* Owner only */
+static
+bool task_queue_push(TaskQueue* q, Allocator a, Task* task){
+	i64 b = atomic_load(&q->bottom, MemoryOrder_Relaxed);
+	i64 t = atomic_load(&q->top, MemoryOrder_Acquire);
+	TaskBuffer* buf = atomic_load(&q->buffer, MemoryOrder_Relaxed);
+
+	if((b - t) > (buf->cap - 1)){
+		buf = task_queue_grow(q, a, buf, t, b);
+		if(!buf){ return false; }
+	}
+
+	atomic_store(&buf->data[b & (buf->cap - 1)], task, MemoryOrder_Relaxed);
+	atomic_fence(MemoryOrder_Release);
+	atomic_store(&q->bottom, b + 1, MemoryOrder_Relaxed);
+	return true;
+}
+
+/* Owner only */
+static
+Task* task_queue_pop(TaskQueue* q){
+	i64 b = atomic_load(&q->bottom, MemoryOrder_Relaxed) - 1;
+	TaskBuffer* buf = atomic_load(&q->buffer, MemoryOrder_Relaxed);
+	atomic_store(&q->bottom, b, MemoryOrder_Relaxed);
+	atomic_fence(MemoryOrder_SeqCst);
+	i64 t = atomic_load(&q->top, MemoryOrder_Relaxed);
+
+	if(t > b){ /* Empty */
+		atomic_store(&q->bottom, b + 1, MemoryOrder_Relaxed);
+		return nullptr;
+	}
+
+	Task* task = atomic_load(&buf->data[b & (buf->cap - 1)], MemoryOrder_Relaxed);
+	if(t == b){ /* Last element, race against thieves */
+		if(!atomic_cas(&q->top, &t, t + 1, MemoryOrder_SeqCst, MemoryOrder_Relaxed)){
+			task = nullptr;
+		}
+		atomic_store(&q->bottom, b + 1, MemoryOrder_Relaxed);
+	}
+	return task;
+}
+
+/* Any thread */
+static
+Task* task_queue_steal(TaskQueue* q){
+	i64 t = atomic_load(&q->top, MemoryOrder_Acquire);
+	atomic_fence(MemoryOrder_SeqCst);
+	i64 b = atomic_load(&q->bottom, MemoryOrder_Acquire);
+
+	if(t >= b){ return nullptr; }
+
+	TaskBuffer* buf = atomic_load(&q->buffer, MemoryOrder_Acquire);
+	Task* task = atomic_load(&buf->data[t & (buf->cap - 1)], MemoryOrder_Relaxed);
+	if(!atomic_cas(&q->top, &t, t + 1, MemoryOrder_SeqCst, MemoryOrder_Relaxed)){
+		return nullptr; /* Lost the race against another thief or the owner */
+	}
+	return task;
+}
+
+static
+bool task_queue_empty(TaskQueue* q){
+	i64 t = atomic_load(&q->top, MemoryOrder_Acquire);
+	i64 b = atomic_load(&q->bottom, MemoryOrder_Acquire);
+	return b <= t;
+}
+
+//// Workers
+static
+u64 worker_random(Worker* w){
+	/* xorshift64 */
+	u64 x = w->rng_state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	w->rng_state = x;
+	return x;
+}
+
+static
+Task* worker_find_task(Worker* w){
+	Task* task = task_queue_pop(&w->queue);
+	if(task){ return task; }
+
+	auto workers = w->scheduler->workers;
+	usize n = workers.len;
+	usize start = usize(worker_random(w) % n);
+	for(usize i = 0; i < n; i += 1){
+		Worker* victim = &workers[(start + i) % n];
+		if(victim == w){ continue; }
+		task = task_queue_steal(&victim->queue);
+		if(task){ return task; }
+	}
+	return nullptr;
+}
+
+/* The task node goes back to the cache of the worker that ran it */
+static
+void task_run(Worker* w, Task* task){
+	task->proc(task->arg);
+	TaskGroup* group = task->group;
+	pool_cache_free(&w->task_cache, task);
+	if(group){
+		atomic_sub(&group->pending, i64(1), MemoryOrder_Release);
+	}
+}
+
+static
+bool sched_has_work(Scheduler* s){
+	for(usize i = 0; i < s->workers.len; i += 1){
+		if(!task_queue_empty(&s->workers[i].queue)){ return true; }
+	}
+	return false;
+}
+
+static
+void sched_wake_one(Scheduler* s){
+	atomic_fence(MemoryOrder_SeqCst);
+	i32 n = atomic_load(&s->sleeping);
+	while(n > 0){
+		if(atomic_cas(&s->sleeping, &n, n - 1)){
+			semaphore_post(s->wake);
+			return;
+		}
+	}
+}
+
+static
+void worker_sleep(Worker* w){
+	Scheduler* s = w->scheduler;
+	atomic_add(&s->sleeping, 1);
+	atomic_fence(MemoryOrder_SeqCst);
+
+	if(sched_has_work(s) || !atomic_load(&s->running)){
+		i32 n = atomic_load(&s->sleeping);
+		while(n > 0){
+			if(atomic_cas(&s->sleeping, &n, n - 1)){ return; }
+		}
+		/* A submitter already took our sleeping slot and posted, consume its token below */
+	}
+	semaphore_wait(s->wake);
+}
+
+static
+void worker_main(void* arg){
+	auto w = (Worker*)arg;
+	Scheduler* s = w->scheduler;
+	sched_current_worker = w;
+
+	i32 idle = 0;
+	while(atomic_load(&s->running, MemoryOrder_Acquire)){
+		Task* task = worker_find_task(w);
+		if(task){
+			task_run(w, task);
+			idle = 0;
+			continue;
+		}
+
+		idle += 1;
+		if(idle < WORKER_SPIN_COUNT){
+			cpu_relax();
+		}
+		else if(idle < WORKER_SPIN_COUNT + WORKER_YIELD_COUNT){
+			thread_yield();
+		}
+		else {
+			worker_sleep(w);
+			idle = 0;
+		}
+	}
+
+	pool_cache_flush(&w->task_cache);
+	cached_heap_thread_flush();
+	sched_current_worker = nullptr;
+}
+
+//// Scheduler
+Scheduler* sched_create(i32 worker_count, Allocator allocator){
+	if(worker_count <= 0){
+		worker_count = cpu_count();
+	}
+
+	auto s = make<Scheduler>(allocator);
+	if(!s){ return nullptr; }
+	s->allocator = allocator;
+	s->running = 1;
+	s->sleeping = 0;
+	s->wake = semaphore_create(0);
+	s->task_pool = pool_create(sizeof(Task), alignof(Task), TASK_POOL_CHUNK_BLOCKS, allocator);
+	s->workers = make_slice<Worker>(allocator, usize(worker_count));
+	if(!s->wake.handle || !s->workers.data){
+		goto fail;
+	}
+
+	for(usize i = 0; i < s->workers.len; i += 1){
+		Worker* w = &s->workers[i];
+		if(!task_queue_init(&w->queue, allocator)){ goto fail; }
+		w->task_cache = pool_cache_create(&s->task_pool);
+		w->scheduler = s;
+		w->id = i32(i);
+		w->rng_state = 0x9e3779b97f4a7c15ull * (i + 1);
+		w->thread = {};
+	}
+
+	sched_current_worker = &s->workers[0];
+	for(usize i = 1; i < s->workers.len; i += 1){
+		Worker* w = &s->workers[i];
+		w->thread = thread_create(worker_main, w);
+		if(!w->thread.handle){ goto fail; }
+	}
+
+	return s;
+
+fail:
+	sched_destroy(s);
+	return nullptr;
+}
+
+void sched_destroy(Scheduler* s){
+	if(!s){ return; }
+
+	atomic_store(&s->running, 0);
+	if(s->wake.handle){
+		semaphore_post(s->wake, i32(s->workers.len));
+	}
+
+	for(usize i = 0; i < s->workers.len; i += 1){
+		Worker* w = &s->workers[i];
+		if(w->thread.handle){
+			thread_join(w->thread);
+		}
+		task_buffer_destroy(s->allocator, w->queue.buffer);
+	}
+	pool_destroy(&s->task_pool);
+
+	if(sched_current_worker && sched_current_worker->scheduler == s){
+		sched_current_worker = nullptr;
+	}
+
+	mem_free(s->allocator, s->workers.data, sizeof(Worker) * s->workers.len, alignof(Worker));
+	semaphore_destroy(s->wake);
+	mem_free(s->allocator, s, sizeof(Scheduler), alignof(Scheduler));
+}
+
+bool sched_submit(Scheduler* s, TaskGroup* group, TaskProc proc, void* arg){
+	Worker* w = sched_current_worker;
+	ensure(w && w->scheduler == s, "Tasks must be submitted from a worker thread");
+
+	auto task = (Task*)pool_cache_alloc_uninit(&w->task_cache);
+	if(!task){ return false; }
+	task->proc = proc;
+	task->arg = arg;
+	task->group = group;
+
+	if(group){
+		atomic_add(&group->pending, i64(1), MemoryOrder_Relaxed);
+	}
+
+	if(!task_queue_push(&w->queue, s->allocator, task)){
+		if(group){
+			atomic_sub(&group->pending, i64(1), MemoryOrder_Relaxed);
+		}
+		pool_cache_free(&w->task_cache, task);
+		return false;
+	}
+
+	sched_wake_one(s);
+	return true;
+}
+
+void sched_wait(Scheduler* s, TaskGroup* group){
+	Worker* w = sched_current_worker;
+	ensure(w && w->scheduler == s, "Tasks must be waited on from a worker thread");
+
+	i32 idle = 0;
+	while(atomic_load(&group->pending, MemoryOrder_Acquire) > 0){
+		Task* task = worker_find_task(w);
+		if(task){
+			task_run(w, task);
+			idle = 0;
+		}
+		else if(idle < WORKER_SPIN_COUNT){
+			cpu_relax();
+			idle += 1;
+		}
+		else {
+			thread_yield();
+		}
+	}
+}
+
+i32 sched_worker_index(Scheduler* s){
+	Worker* w = sched_current_worker;
+	if(w && w->scheduler == s){
+		return w->id;
+	}
+	return -1;
+}
@@ -1,4 +1,134 @@
 #pragma once
 #include "base.hpp"
 
+//// CRC32
 u32 crc32(Slice<u8> buf);
+
+// Reference implementation, one table lookup per byte
+u32 crc32_bytewise(Slice<u8> buf);
+
+// Table driven implementations consuming 8 and 16 bytes per step
+u32 crc32_slice8(Slice<u8> buf);
+
+u32 crc32_slice16(Slice<u8> buf);
+
+#if defined(__x86_64__) || defined(__i386__)
+// Carry-less multiply folding, callers must check cpu_has() first. crc32() picks the best one.
+u32 crc32_pclmul(Slice<u8> buf);
+
+u32 crc32_vpclmul(Slice<u8> buf);
+#endif
+
+// Name of the implementation crc32() dispatches to
+cstring crc32_implementation();
+
+// Incremental CRC32, feeding a buffer in pieces gives the same result as crc32() over all of it
+struct CRC32_State {
+	u32 remainder;
+};
+
+CRC32_State crc32_begin();
+
+void crc32_update(CRC32_State* state, Slice<u8> buf);
+
+u32 crc32_finish(CRC32_State* state);
+
+// CRC32 of A followed by B, given crc32(A), crc32(B) and the length of B
+u32 crc32_combine(u32 crc_a, u32 crc_b, usize len_b);
+
+// CRC32 of a whole file, mapped when possible and streamed in chunks otherwise so pipes work too.
+// Returns false if the file could not be opened or read.
+bool crc32_file(String path, u32* crc);
+
+//// Scheduler
+using TaskProc = void (*)(void* arg);
+
+// Counter of in-flight tasks, tasks submitted with a group decrement it once they finish
+struct TaskGroup {
+	i64 pending;
+};
+
+struct Task {
+	TaskProc   proc;
+	void*      arg;
+	TaskGroup* group;
+};
+
+// Ring buffer backing a TaskQueue, old buffers are kept alive until the scheduler is destroyed
+// because thieves may still be reading from them.
+struct TaskBuffer {
+	Task**      data;
+	i64         cap;
+	TaskBuffer* prev;
+};
+
+// Chase-Lev work stealing deque. The owner pushes and pops at the bottom, thieves steal from the top.
+// Padding keeps top (written by thieves) and bottom (written by the owner) on separate cache lines.
+struct TaskQueue {
+	u8  _pad0[64];
+	i64 top;
+	u8  _pad1[64 - sizeof(i64)];
+	i64 bottom;
+	TaskBuffer* buffer;
+	u8  _pad2[64 - sizeof(i64) - sizeof(TaskBuffer*)];
+};
+
+struct Scheduler;
+
+struct Worker {
+	TaskQueue  queue;
+	PoolCache  task_cache;
+	Scheduler* scheduler;
+	Thread     thread;
+	u64        rng_state;
+	i32        id;
+};
+
+struct Scheduler {
+	Slice<Worker> workers;
+	Pool          task_pool;
+	Allocator     allocator;
+	Semaphore     wake;
+	i32           sleeping;
+	i32           running;
+};
+
+// Create a scheduler with `worker_count` workers (0 means one per logical processor). The calling
+// thread becomes worker 0 and only executes tasks from inside sched_wait. Task nodes come from a
+// pool with a cache per worker, the allocator only backs the pool's chunks and the queues and may
+// be called from any worker so it must be thread safe. Returns nullptr on failure.
+Scheduler* sched_create(i32 worker_count, Allocator allocator);
+
+// Stop and join all workers. Every group must have been waited on before calling this.
+void sched_destroy(Scheduler* s);
+
+// Push a task on the current worker's queue. Must be called from a worker thread (including
+// tasks themselves). Returns false if the task could not be allocated.
+bool sched_submit(Scheduler* s, TaskGroup* group, TaskProc proc, void* arg);
+
+// Block until every task in the group finished, executing queued tasks in the meantime.
+void sched_wait(Scheduler* s, TaskGroup* group);
+
+// Index of the worker running the current thread, -1 if the thread does not belong to the scheduler
+i32 sched_worker_index(Scheduler* s);
+
+//// CRC32C
+// Castagnoli CRC (reflected, initial value and final xor of 0xffffffff), as used by iSCSI, ext4
+// and most storage/wire formats. Uses the SSE4.2 crc32 instruction when available.
+u32 crc32c(Slice<u8> buf);
+
+// Continue a checksum: crc32c_update(crc32c(A), B) == crc32c(A || B), start from 0
+u32 crc32c_update(u32 crc, Slice<u8> buf);
+
+// Table driven implementation consuming 8 bytes per step
+u32 crc32c_slice8(Slice<u8> buf);
+
+#if defined(__x86_64__)
+// Hardware implementation, callers must check cpu_has(CPUFeature_SSE42) first
+u32 crc32c_sse42(Slice<u8> buf);
+#endif
+
+//// Parallel CRC32
+// Split the buffer across the scheduler's workers and combine the partial checksums.
+// Must be called from a worker thread, small buffers are hashed on the calling thread.
+u32 crc32_parallel(Scheduler* sched, Slice<u8> buf);
@@ -2,31 +2,43 @@
 
 #include <stdio.h>
 
-Slice<u8> file_read(String path, Arena* arena);
 i64 file_write(String path, Slice<u8> data);
 
-constexpr usize SCRATCH_ARENA_SIZE = 8 * 1024LL * 1024LL;
+constexpr usize SCRATCH_ARENA_RESERVE = 1024LL * 1024LL * 1024LL;
 thread_local Arena scratch_arena = {};
 
 void init(){
-	auto buf = make_slice<u8>(heap_allocator(), SCRATCH_ARENA_SIZE);
-	scratch_arena = arena_from_buffer(buf);
+	scratch_arena = arena_create_virtual(SCRATCH_ARENA_RESERVE, ArenaFlag_DecommitOnReset);
+	ensure(scratch_arena.data, "Failed to reserve scratch arena");
 }
 
 struct CRC32_Table {
 	u32 entries[256];
 };
 
-void crc32_fill_table(CRC32_Table* table, u32 polynomial) {
+// Parameters of a generated CRC32 variant. Reflected CRCs shift the register right and take the
+// polynomial in reversed bit order, like the hardware crc32 instruction.
+struct CRC32_Params {
+	String name;
+	String constant_prefix;
+	u32    polynomial;
+	bool   reflected;
+	usize  slice_count;
+};
+
+void crc32_fill_table(CRC32_Table* table, u32 polynomial, bool reflected) {
 	constexpr u32 bit_width = sizeof(u32) * 8;
 	constexpr u32 top_bit = (u32(1) << (bit_width - 1));
     u32 remainder = 0;
 
     for (int dividend = 0; dividend < 256; dividend += 1) {
-        remainder = dividend << (bit_width - 8);
+        remainder = reflected ? u32(dividend) : (dividend << (bit_width - 8));
 
         for (u8 bit = 8; bit > 0; --bit){
-            if (remainder & top_bit) {
+            if (reflected) {
+                remainder = (remainder & 1) ? ((remainder >> 1) ^ polynomial) : (remainder >> 1);
+            }
+            else if (remainder & top_bit) {
                 remainder = (remainder << 1) ^ polynomial;
             }
             else {
@@ -37,33 +49,125 @@ void crc32_fill_table(CRC32_Table* table, u32 polynomial) {
     }
 }
 
-struct StringBuilder {
-	List<u8> buf;
+constexpr usize CRC32_MAX_SLICE_COUNT = 16;
+
+struct CRC32_SlicedTable {
+	u32 entries[CRC32_MAX_SLICE_COUNT][256];
 };
 
-StringBuilder builder_create(usize cap, Allocator alloc){
-	StringBuilder sb = { make_list<u8>(alloc, 0, cap) };
-	return sb;
+// Row k holds the remainder of a byte followed by k zero bytes, row 0 is the regular table
+void crc32_fill_sliced_table(CRC32_SlicedTable* sliced, CRC32_Table const& table, bool reflected){
+	for(usize i = 0; i < 256; i += 1){
+		sliced->entries[0][i] = table.entries[i];
+	}
+
+	for(usize k = 1; k < CRC32_MAX_SLICE_COUNT; k += 1){
+		for(usize i = 0; i < 256; i += 1){
+			u32 prev = sliced->entries[k - 1][i];
+			sliced->entries[k][i] = reflected ?
+				((prev >> 8) ^ table.entries[prev & 0xff]) :
+				((prev << 8) ^ table.entries[prev >> 24]);
+		}
+	}
+}
+
+// Operator appending `len` zero bytes to a reflected CRC register, split into one table per
+// register byte so it can be applied as shift[0][b0] ^ shift[1][b1] ^ shift[2][b2] ^ shift[3][b3]
+void crc32_fill_shift_table_reflected(u32 (*shift)[256], CRC32_Table const& table, usize len){
+	for(usize k = 0; k < 4; k += 1){
+		for(usize i = 0; i < 256; i += 1){
+			u32 remainder = u32(i) << (8 * k);
+			for(usize n = 0; n < len; n += 1){
+				remainder = table.entries[remainder & 0xff] ^ (remainder >> 8);
+			}
+			shift[k][i] = remainder;
+		}
+	}
+}
+
+// x^n mod P, where P has an implicit x^32 term
+u32 crc32_xpow_mod(u64 n, u32 polynomial){
+	u32 remainder = 1;
+	for(u64 i = 0; i < n; i += 1){
+		remainder = (remainder & 0x80000000) ? ((remainder << 1) ^ polynomial) : (remainder << 1);
+	}
+	return remainder;
 }
 
-bool builder_append(StringBuilder* sb, String str){
-	if((sb->buf.len + str.len) >= sb->buf.cap){
-		if(!resize(&sb->buf, max<usize>(16, sb->buf.len + str.len))){
-			return false;
+// a * b mod P
+u32 crc32_multmodp(u32 a, u32 b, u32 polynomial){
+	u32 product = 0;
+	for(i32 bit = 31; bit >= 0; bit -= 1){
+		product = (product & 0x80000000) ? ((product << 1) ^ polynomial) : (product << 1);
+		if((b >> bit) & 1){
+			product ^= a;
 		}
 	}
+	return product;
+}
+
+constexpr usize CRC32_XPOW_COUNT = 64;
 
-	mem_copy(&sb->buf.data[sb->buf.len], str.data, str.len);
-	sb->buf.len += str.len;
-	return true;
+// Entry k is x^(8 * 2^k) mod P, the operator for appending 2^k zero bytes
+void crc32_fill_xpow8n(u32* table, u32 polynomial){
+	table[0] = crc32_xpow_mod(8, polynomial);
+	for(usize k = 1; k < CRC32_XPOW_COUNT; k += 1){
+		table[k] = crc32_multmodp(table[k - 1], table[k - 1], polynomial);
+	}
 }
 
-String builder_string(StringBuilder const& sb){
-	return String((char const*)sb.buf.data, sb.buf.len);
+constexpr usize CRC32_FOLD_COUNT = 17;
+
+// Block sizes of the three interleaved hardware CRC32C streams
+constexpr usize CRC32C_LONG_BLOCK = 8192;
+constexpr usize CRC32C_SHORT_BLOCK = 256;
+
+// Carry-less multiply folding constants, entry d moves a 128 bit block forward by 128*d bits:
+// { x^(128*d) mod P, x^(128*d + 64) mod P } for the low and high halves respectively
+void crc32_fill_fold_constants(u64 (*k)[2], u32 polynomial){
+	for(usize d = 0; d < CRC32_FOLD_COUNT; d += 1){
+		k[d][0] = crc32_xpow_mod(128 * d, polynomial);
+		k[d][1] = crc32_xpow_mod(128 * d + 64, polynomial);
+	}
 }
 
-Slice<u8> builder_bytes(StringBuilder const& sb){
-	return slice(sb.buf);
+void builder_append_u32_rows(StringBuilder* sb, u32 const* entries, usize count, String indent){
+	builder_append(sb, indent);
+	for(usize i = 0; i < count; i += 1){
+		if(i && (i % 8 == 0)){
+			builder_append(sb, "\n");
+			builder_append(sb, indent);
+		}
+		builder_append(sb, "0x");
+		builder_append_hex(sb, entries[i], 4);
+		builder_append_byte(sb, ',');
+	}
+}
+
+// Emit <name>_lut, <name>_lut_sliced and <PREFIX>_POLYNOMIAL for the given variant
+void builder_append_crc32_tables(StringBuilder* sb, CRC32_Params const& params){
+	ensure(params.slice_count >= 1 && params.slice_count <= CRC32_MAX_SLICE_COUNT, "Invalid slice count");
+
+	auto table = CRC32_Table{0};
+	crc32_fill_table(&table, params.polynomial, params.reflected);
+
+	auto sliced = make<CRC32_SlicedTable>(&scratch_arena);
+	ensure(sliced, "Failed to allocate sliced table");
+	crc32_fill_sliced_table(sliced, table, params.reflected);
+
+	builder_printf(sb, "constexpr u32 %.*s_lut[] = {\n", str_fmt(params.name));
+	builder_append_u32_rows(sb, table.entries, 256, "\t");
+	builder_append(sb, "\n};\n");
+
+	builder_printf(sb, "constexpr u32 %.*s_lut_sliced[%zu][256] = {\n", str_fmt(params.name), params.slice_count);
+	for(usize k = 0; k < params.slice_count; k += 1){
+		builder_append(sb, "\t{\n");
+		builder_append_u32_rows(sb, sliced->entries[k], 256, "\t\t");
+		builder_append(sb, "\n\t},\n");
+	}
+	builder_append(sb, "};\n");
+
+	builder_printf(sb, "constexpr u32 %.*s_POLYNOMIAL = 0x%08x;\n", str_fmt(params.constant_prefix), params.polynomial);
 }
 
 int main(){
@@ -71,29 +175,35 @@ int main(){
 
 	auto allocator = arena_allocator(&scratch_arena);
 	/* Generate CRC32 */ {
-		constexpr u32 CRC32_POLYNOMIAL = 0xEDB88320;
+		CRC32_Params params = { "crc32", "CRC32", 0xEDB88320, false, 16 };
 
 		auto sb = builder_create(512, allocator);
-		auto base_impl = String(file_read("assets/crc32.cpp", &scratch_arena));
+		auto base_impl = file_map("assets/crc32.cpp");
 		ensure(base_impl.data, "Failed to read crc32 file.");
 
-		auto poly_decl = arena_printf(&scratch_arena, "constexpr u32 CRC32_POLYNOMIAL = 0x%08x;\n", CRC32_POLYNOMIAL);
-
-		auto table = CRC32_Table{0};
-		crc32_fill_table(&table, CRC32_POLYNOMIAL);
-
-		builder_append(&sb, arena_printf(&scratch_arena, "/* Generated by %s */\n", __FILE__));
-		builder_append(&sb, "constexpr u32 crc32_lut[] = {\n\t");
-		for(usize i = 0; i < 256; i += 1){
-			if(i && (i % 8 == 0)){
-				builder_append(&sb, "\n\t");
-			}
-			builder_append(&sb, arena_printf(&scratch_arena, "0x%04x,", u32(table.entries[i])));
+		builder_printf(&sb, "/* Generated by %s */\n", __FILE__);
+		builder_append_crc32_tables(&sb, params);
+
+		u64 fold_k[CRC32_FOLD_COUNT][2] = {};
+		crc32_fill_fold_constants(fold_k, params.polynomial);
+		builder_printf(&sb, "constexpr u64 crc32_fold_k[%zu][2] = {\n", CRC32_FOLD_COUNT);
+		for(usize d = 0; d < CRC32_FOLD_COUNT; d += 1){
+			builder_append(&sb, "\t{0x");
+			builder_append_hex(&sb, fold_k[d][0], 8);
+			builder_append(&sb, ", 0x");
+			builder_append_hex(&sb, fold_k[d][1], 8);
+			builder_append(&sb, "},\n");
 		}
+		builder_append(&sb, "};\n");
+
+		u32 xpow8n[CRC32_XPOW_COUNT] = {};
+		crc32_fill_xpow8n(xpow8n, params.polynomial);
+		builder_printf(&sb, "constexpr u32 crc32_xpow8n[%zu] = {\n", CRC32_XPOW_COUNT);
+		builder_append_u32_rows(&sb, xpow8n, CRC32_XPOW_COUNT, "\t");
 		builder_append(&sb, "\n};\n");
 
-		builder_append(&sb, poly_decl);
-		builder_append(&sb, base_impl);
+		builder_append(&sb, String(base_impl));
+		file_unmap(base_impl);
 
 		i64 written = file_write("crc32.gen.cpp", builder_bytes(sb));
 		printf("-> Generate crc32.gen.cpp (%.1g KiB)\n", f64(written) / f64(1024));
@@ -101,54 +211,61 @@ int main(){
 		ensure(written > 0, "Failed to write file");
 		arena_reset(&scratch_arena);
 	}
-}
 
-i64 file_write(String path, Slice<u8> buf){
-	FILE* fd = nullptr;
+	/* Generate CRC32C (Castagnoli) */ {
+		CRC32_Params params = { "crc32c", "CRC32C", 0x82F63B78, true, 8 };
 
-	/* Open file */ {
-		auto reg = arena_region_begin(&scratch_arena);
-		auto path_null = clone_to_cstring(path, &scratch_arena);
+		auto sb = builder_create(512, allocator);
+		auto base_impl = file_map("assets/crc32c.cpp");
+		ensure(base_impl.data, "Failed to read crc32c file.");
 
-		fd = fopen(path_null, "wb");
-		arena_region_end(reg);
+		builder_printf(&sb, "/* Generated by %s */\n", __FILE__);
+		builder_append_crc32_tables(&sb, params);
 
-		if(fd == nullptr){ return -1; }
-	}
+		auto table = CRC32_Table{0};
+		crc32_fill_table(&table, params.polynomial, params.reflected);
+
+		struct { cstring name; usize len; } shifts[] = {
+			{ "crc32c_shift_long",  CRC32C_LONG_BLOCK },
+			{ "crc32c_shift_short", CRC32C_SHORT_BLOCK },
+		};
+		for(auto const& shift : shifts){
+			u32 entries[4][256] = {};
+			crc32_fill_shift_table_reflected(entries, table, shift.len);
+			builder_printf(&sb, "constexpr u32 %s[4][256] = {\n", shift.name);
+			for(usize k = 0; k < 4; k += 1){
+				builder_append(&sb, "\t{\n");
+				builder_append_u32_rows(&sb, entries[k], 256, "\t\t");
+				builder_append(&sb, "\n\t},\n");
+			}
+			builder_append(&sb, "};\n");
+		}
+		builder_printf(&sb, "constexpr usize CRC32C_LONG_BLOCK = %zu;\n", CRC32C_LONG_BLOCK);
+		builder_printf(&sb, "constexpr usize CRC32C_SHORT_BLOCK = %zu;\n", CRC32C_SHORT_BLOCK);
 
-	return i64(fwrite(buf.data, 1, buf.len, fd));
+		builder_append(&sb, String(base_impl));
+		file_unmap(base_impl);
+
+		i64 written = file_write("crc32c.gen.cpp", builder_bytes(sb));
+		printf("-> Generate crc32c.gen.cpp (%.1g KiB)\n", f64(written) / f64(1024));
+
+		ensure(written > 0, "Failed to write file");
+		arena_reset(&scratch_arena);
+	}
 }
 
-Slice<u8> file_read(String path, Arena* arena){
+i64 file_write(String path, Slice<u8> buf){
 	FILE* fd = nullptr;
-	usize file_size = 0;
-	Slice<u8> buf = {};
 
 	/* Open file */ {
 		auto reg = arena_region_begin(&scratch_arena);
 		auto path_null = clone_to_cstring(path, &scratch_arena);
 
-		fd = fopen(path_null, "rb");
+		fd = fopen(path_null, "wb");
 		arena_region_end(reg);
 
-		if(fd == nullptr){ return {}; }
-	}
-
-	fseek(fd, 0, SEEK_END);
-	usize end = ftell(fd);
-	rewind(fd);
-	usize begin = ftell(fd);
-	file_size = end - begin;
-
-	buf = make_slice<u8>(arena, file_size + 1);
-	if(buf.len != (file_size + 1)){
-		goto exit;
+		if(fd == nullptr){ return -1; }
 	}
-	buf.len -= 1;
 
-	fread(buf.data, 1, file_size, fd);
-
-exit:
-	fclose(fd);
-	return buf;
+	return i64(fwrite(buf.data, 1, buf.len, fd));
 }
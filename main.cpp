@@ -1,15 +1,14 @@
 #include "base.hpp"
 
 #include "ft_sched.hpp"
+#include "config_ini.hpp"
 #include "crc32.gen.cpp"
+#include "crc32c.gen.cpp"
 
 extern "C" {
 	int printf(char const*, ...);
 }
 
-// - CRC32
-// - Task interface
-
 template<class T>
 void print_list(List<T> const& list, char const* elem_fmt){
 	printf("len: %td cap: %td [ ", list.len, list.cap);
@@ -19,7 +18,81 @@ void print_list(List<T> const& list, char const* elem_fmt){
 	} printf("]\n");
 }
 
+struct SumJob {
+	Slice<u32> items;
+	u64* total;
+};
+
+void sum_job(void* arg){
+	auto job = (SumJob*)arg;
+	u64 acc = 0;
+	for(usize i = 0; i < job->items.len; i ++){
+		acc += job->items[i];
+	}
+	atomic_add(job->total, acc);
+}
+
+void task_demo(){
+	auto sched = sched_create(0, heap_allocator());
+	ensure(sched, "Failed to create scheduler");
+
+	auto items = make_slice<u32>(heap_allocator(), 1 << 20);
+	for(usize i = 0; i < items.len; i ++){
+		items[i] = u32(i);
+	}
+
+	constexpr usize job_count = 64;
+	SumJob jobs[job_count];
+	u64 total = 0;
+	TaskGroup group = {};
+	usize chunk = items.len / job_count;
+	for(usize i = 0; i < job_count; i ++){
+		jobs[i] = SumJob{ slice(items, i * chunk, (i + 1) * chunk), &total };
+		sched_submit(sched, &group, sum_job, &jobs[i]);
+	}
+	sched_wait(sched, &group);
+
+	printf("sum of %zu items on %zu workers: %llu\n", items.len, sched->workers.len, (unsigned long long)total);
+
+	mem_free(heap_allocator(), items.data, sizeof(u32) * items.len, alignof(u32));
+	sched_destroy(sched);
+}
+
+void ini_demo(){
+	String source =
+		"; scheduler settings\n"
+		"name = demo\n"
+		"[scheduler]\n"
+		"workers = 4\n"
+		"spin = 64\n"
+		"[crc]\n"
+		"parallel = true\n";
+
+	auto arena = arena_create_virtual(1024 * 1024);
+	INI_Document doc;
+	INI_Error error = {};
+	if(!ini_parse(source, &arena, &doc, &error)){
+		printf("ini error at line %u: %s\n", error.line, error.message);
+		arena_destroy(&arena);
+		return;
+	}
+
+	for(INI_Section* section = doc.first_section; section; section = section->next){
+		printf("[%.*s]\n", str_fmt(section->name));
+		for(INI_Entry* entry = section->first_entry; entry; entry = entry->next){
+			printf("  %.*s = %.*s\n", str_fmt(entry->key), str_fmt(entry->value));
+		}
+	}
+	printf("scheduler.workers = %.*s\n", str_fmt(ini_get(&doc, "scheduler", "workers", "0")));
+	arena_destroy(&arena);
+}
+
 int main(){
+	task_demo();
+
+	String msg = "Hello, world";
+	printf("crc32(\"%.*s\") = 0x%08x (%s)\n", str_fmt(msg), crc32(Slice<u8>{(u8*)msg.data, msg.len}), crc32_implementation());
+
 	auto nums = make_list<f32>(heap_allocator());
 
 	for(f32 i = 0; i < 30; i++){
@@ -39,4 +112,6 @@ int main(){
 		print_list(nums, "%.1f");
 	}
 
+	ini_demo();
+
 }
\ No newline at end of file